@@ -0,0 +1,484 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+#include <Genode/IO/FileSystems/LocalFileSystem.hpp>
+#include <Genode/IO/FileSystems/PackFileSystem.hpp>
+#include <Genode/IO/IOException.hpp>
+#include <Genode/IO/ResourceManager.hpp>
+
+namespace
+{
+    struct Options
+    {
+        std::string   Root         = "genode-asset-bench";
+        std::string   Output;
+        std::string   Distribution = "lognormal";
+        std::size_t   FileCount    = 2000;
+        std::size_t   MeanSize     = 64 * 1024;
+        std::size_t   Depth        = 3;
+        std::size_t   Fanout       = 4;
+        std::size_t   Workers      = 0;
+        std::uint64_t DecodeNsPerKB = 2000;
+        bool          Keep          = false;
+    };
+
+    struct Asset
+    {
+        std::size_t   Size;
+        std::uint64_t Checksum;
+    };
+
+    std::uint64_t DecodeNsPerKB = 0;
+    bool          MapFiles      = false;
+
+    /// Loads the asset through FileSystem and simulates the decoding cost proportional to the asset size.
+    class AssetLoader : public Gx::IResourceLoader<Asset>
+    {
+    public:
+        std::unique_ptr<Asset> LoadFromFile(const std::string &fileName, const Gx::ResourceContext &ctx) override
+        {
+            if (MapFiles)
+            {
+                auto view = Gx::FileSystem::Map(fileName);
+                if (!view)
+                    throw Gx::ResourceLoadException("Failed to map [" + fileName + "]");
+
+                return Decode(view.GetData(), view.GetSize());
+            }
+
+            auto stream = Gx::FileSystem::Open(fileName);
+            if (!stream)
+                throw Gx::ResourceLoadException("Failed to open [" + fileName + "]");
+
+            return LoadFromStream(*stream, ctx);
+        }
+
+        std::unique_ptr<Asset> LoadFromMemory(void *data, std::size_t size, const Gx::ResourceContext &) override
+        {
+            return Decode(static_cast<const unsigned char*>(data), size);
+        }
+
+        std::unique_ptr<Asset> LoadFromStream(sf::InputStream &stream, const Gx::ResourceContext &) override
+        {
+            auto size = stream.getSize();
+            if (size < 0)
+                return nullptr;
+
+            m_buffer.resize(static_cast<std::size_t>(size));
+            if (size > 0 && stream.read(m_buffer.data(), size) != size)
+                return nullptr;
+
+            return Decode(m_buffer.data(), m_buffer.size());
+        }
+
+    private:
+        static std::unique_ptr<Asset> Decode(const unsigned char *data, std::size_t size)
+        {
+            std::uint64_t checksum = 1469598103934665603ull;
+            for (std::size_t i = 0; i < size; i++)
+                checksum = (checksum ^ data[i]) * 1099511628211ull;
+
+            // Busy wait to emulate decoding that is bound by CPU rather than I/O
+            auto cost     = std::chrono::nanoseconds(DecodeNsPerKB * size / 1024);
+            auto deadline = std::chrono::steady_clock::now() + cost;
+            while (std::chrono::steady_clock::now() < deadline)
+                continue;
+
+            return std::make_unique<Asset>(Asset{ size, checksum });
+        }
+
+        std::vector<unsigned char> m_buffer;
+    };
+
+    struct ProcessCounters
+    {
+        std::uint64_t ReadSyscalls = 0;
+        std::uint64_t MajorFaults  = 0;
+        std::uint64_t MinorFaults  = 0;
+        std::uint64_t PeakRSS      = 0;
+    };
+
+    ProcessCounters GetProcessCounters()
+    {
+        ProcessCounters counters;
+#if defined(__linux__)
+        std::ifstream io("/proc/self/io");
+        std::string key;
+        std::uint64_t value;
+        while (io >> key >> value)
+        {
+            if (key == "syscr:")
+                counters.ReadSyscalls = value;
+        }
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+        counters.MajorFaults = static_cast<std::uint64_t>(usage.ru_majflt);
+        counters.MinorFaults = static_cast<std::uint64_t>(usage.ru_minflt);
+    #if defined(__APPLE__)
+        counters.PeakRSS     = static_cast<std::uint64_t>(usage.ru_maxrss);
+    #else
+        counters.PeakRSS     = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+#endif
+        return counters;
+    }
+
+    /// Evict the given files from the page cache, returns false if the platform doesn't permit it.
+    bool DropPageCache(const std::vector<std::string> &files)
+    {
+#if defined(__linux__)
+        for (auto &file : files)
+        {
+            int fd = open(file.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            fdatasync(fd);
+            int result = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+
+            if (result != 0)
+                return false;
+        }
+
+        return true;
+#else
+        (void)files;
+        return false;
+#endif
+    }
+
+    void WarmPageCache(const std::vector<std::string> &files)
+    {
+        std::vector<char> buffer(1024 * 1024);
+        for (auto &file : files)
+        {
+            std::ifstream stream(file, std::ios::binary);
+            while (stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+                continue;
+        }
+    }
+
+    std::size_t NextSize(const Options &options, std::mt19937_64 &random)
+    {
+        auto mean = static_cast<double>(options.MeanSize);
+        if (options.Distribution == "fixed")
+            return options.MeanSize;
+        else if (options.Distribution == "uniform")
+            return std::uniform_int_distribution<std::size_t>(1, options.MeanSize * 2)(random);
+
+        // Asset sizes are heavily skewed: most assets are small, few are large
+        constexpr double sigma = 1.0;
+        auto distribution = std::lognormal_distribution<double>(std::log(mean) - sigma * sigma / 2, sigma);
+        return std::max<std::size_t>(1, static_cast<std::size_t>(distribution(random)));
+    }
+
+    std::vector<std::string> GenerateTree(const Options &options, const std::string &root, std::size_t &totalBytes)
+    {
+        namespace fs = std::filesystem;
+
+        auto leaves = std::vector<std::string>{ "" };
+        for (std::size_t level = 0; level < options.Depth; level++)
+        {
+            std::vector<std::string> next;
+            for (auto &leaf : leaves)
+            {
+                for (std::size_t i = 0; i < options.Fanout; i++)
+                    next.push_back(leaf + "dir" + std::to_string(i) + "/");
+            }
+
+            leaves = std::move(next);
+        }
+
+        std::mt19937_64 random(42);
+        std::vector<std::string> names;
+        std::vector<char> content;
+        totalBytes = 0;
+
+        fs::remove_all(root);
+        for (std::size_t i = 0; i < options.FileCount; i++)
+        {
+            auto name = leaves[i % leaves.size()] + "asset" + std::to_string(i) + ".bin";
+            auto path = fs::path(root) / name;
+            fs::create_directories(path.parent_path());
+
+            content.resize(NextSize(options, random));
+            for (auto &c : content)
+                c = static_cast<char>(random());
+
+            std::ofstream(path, std::ios::binary).write(content.data(), static_cast<std::streamsize>(content.size()));
+            names.push_back(name);
+            totalBytes += content.size();
+        }
+
+        return names;
+    }
+
+    struct Scenario
+    {
+        std::string Deployment;
+        std::string Cache;
+        std::string Execution;
+        double      WallSeconds        = 0;
+        double      SyscallsPerAsset   = 0;
+        double      MajorFaultsPerAsset = 0;
+        double      MinorFaultsPerAsset = 0;
+        std::uint64_t PeakRSS          = 0;
+        bool        Skipped            = false;
+    };
+
+    using FileSystemFactory = std::function<std::unique_ptr<Gx::IFileSystem>()>;
+
+    Scenario Run(const Options &options, const std::vector<std::string> &names, const std::vector<std::string> &diskFiles,
+                 const std::string &deployment, const FileSystemFactory &mount, const std::string &cache, const std::string &execution)
+    {
+        Scenario scenario;
+        scenario.Deployment = deployment;
+        scenario.Cache      = cache;
+        scenario.Execution  = execution;
+
+        // Prefetch starts from a cold cache, the hints are issued right before the loads
+        bool prefetch = cache == "prefetch";
+        if (cache == "cold" || prefetch)
+            scenario.Skipped = !DropPageCache(diskFiles);
+        else
+            WarmPageCache(diskFiles);
+
+        if (scenario.Skipped)
+            return scenario;
+
+        // Mount after the page cache is prepared, file systems may keep the archive mapped while mounted
+        auto fs      = mount();
+        auto mounted = fs.get();
+        Gx::FileSystem::Mount(std::move(fs), 100);
+
+        auto before = GetProcessCounters();
+        auto start  = std::chrono::steady_clock::now();
+        if (prefetch)
+            Gx::FileSystem::Prefetch(names);
+
+        {
+            Gx::ResourceManager resources;
+            resources.SetWorkerCount(options.Workers);
+
+            if (execution == "batch")
+            {
+                // Files are read as a single batch, then decoded in parallel while their content is kept alive
+                auto local   = static_cast<Gx::LocalFileSystem*>(mounted);
+                auto results = local->ReadBatch(names).get();
+
+                std::vector<Gx::ResourceFuture<Asset>> futures;
+                futures.reserve(names.size());
+                for (auto &result : results)
+                {
+                    if (result.IsSuccess())
+                        futures.push_back(resources.AddFromMemoryAsync<Asset>(names[result.Index], result.Data, result.Size));
+                }
+
+                for (auto &future : futures)
+                    future.Get();
+            }
+            else if (execution == "parallel")
+            {
+                std::vector<Gx::ResourceFuture<Asset>> futures;
+                futures.reserve(names.size());
+                for (auto &name : names)
+                    futures.push_back(resources.AddFromFileAsync<Asset>(name, name));
+
+                for (auto &future : futures)
+                    future.Get();
+            }
+            else
+            {
+                for (auto &name : names)
+                    resources.AddFromFile<Asset>(name, name);
+            }
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after   = GetProcessCounters();
+        Gx::FileSystem::Dismount(mounted);
+        auto count   = static_cast<double>(names.size());
+
+        scenario.WallSeconds         = std::chrono::duration<double>(elapsed).count();
+        scenario.SyscallsPerAsset    = static_cast<double>(after.ReadSyscalls - before.ReadSyscalls) / count;
+        scenario.MajorFaultsPerAsset = static_cast<double>(after.MajorFaults - before.MajorFaults) / count;
+        scenario.MinorFaultsPerAsset = static_cast<double>(after.MinorFaults - before.MinorFaults) / count;
+        scenario.PeakRSS             = after.PeakRSS;
+
+        return scenario;
+    }
+
+    void WriteJson(std::ostream &output, const Options &options, std::size_t totalBytes, const std::vector<Scenario> &scenarios)
+    {
+        output << "{\n"
+               << "  \"files\": " << options.FileCount << ",\n"
+               << "  \"total_bytes\": " << totalBytes << ",\n"
+               << "  \"distribution\": \"" << options.Distribution << "\",\n"
+               << "  \"decode_ns_per_kb\": " << options.DecodeNsPerKB << ",\n"
+               << "  \"scenarios\": [";
+
+        for (std::size_t i = 0; i < scenarios.size(); i++)
+        {
+            auto &s = scenarios[i];
+            output << (i == 0 ? "\n" : ",\n")
+                   << "    {\"deployment\": \"" << s.Deployment << "\", \"cache\": \"" << s.Cache << "\", \"execution\": \"" << s.Execution << "\", ";
+
+            if (s.Skipped)
+            {
+                output << "\"skipped\": true}";
+                continue;
+            }
+
+            output << std::fixed << std::setprecision(6)
+                   << "\"wall_seconds\": " << s.WallSeconds << ", "
+                   << std::setprecision(3)
+                   << "\"read_syscalls_per_asset\": " << s.SyscallsPerAsset << ", "
+                   << "\"major_faults_per_asset\": " << s.MajorFaultsPerAsset << ", "
+                   << "\"minor_faults_per_asset\": " << s.MinorFaultsPerAsset << ", "
+                   << "\"peak_rss_bytes\": " << s.PeakRSS << "}";
+        }
+
+        output << "\n  ]\n}\n";
+    }
+
+    bool ParseOptions(int argc, char *argv[], Options &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            bool hasValue   = i + 1 < argc;
+            if (arg == "--keep")
+                options.Keep = true;
+            else if (!hasValue)
+                return false;
+            else if (arg == "--root")
+                options.Root = argv[++i];
+            else if (arg == "--output")
+                options.Output = argv[++i];
+            else if (arg == "--files")
+                options.FileCount = std::stoul(argv[++i]);
+            else if (arg == "--mean-size")
+                options.MeanSize = std::stoul(argv[++i]);
+            else if (arg == "--distribution")
+                options.Distribution = argv[++i];
+            else if (arg == "--depth")
+                options.Depth = std::stoul(argv[++i]);
+            else if (arg == "--fanout")
+                options.Fanout = std::max<std::size_t>(1, std::stoul(argv[++i]));
+            else if (arg == "--workers")
+                options.Workers = std::stoul(argv[++i]);
+            else if (arg == "--decode-ns-per-kb")
+                options.DecodeNsPerKB = std::stoull(argv[++i]);
+            else
+                return false;
+        }
+
+        return options.FileCount > 0 && options.MeanSize > 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: Genode.IO.AssetBench [--files <n>] [--mean-size <bytes>] [--distribution fixed|uniform|lognormal]" << std::endl
+                  << "                            [--depth <n>] [--fanout <n>] [--workers <n>] [--decode-ns-per-kb <ns>]" << std::endl
+                  << "                            [--root <directory>] [--output <file.json>] [--keep]" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        DecodeNsPerKB = options.DecodeNsPerKB;
+        Gx::ResourceLoaderFactory::Register<Asset, AssetLoader>();
+        Gx::ResourceLoaderFactory::UseCachedLoaders(true);
+
+        std::size_t totalBytes = 0;
+        auto tree    = options.Root + "/tree";
+        auto archive = options.Root + "/assets.pack";
+        auto names   = GenerateTree(options, tree, totalBytes);
+
+        auto writer = Gx::PackWriter();
+        writer.AddDirectory(tree);
+        writer.Save(archive);
+
+        std::vector<std::string> looseFiles;
+        for (auto &name : names)
+            looseFiles.push_back(tree + "/" + name);
+
+        std::vector<Scenario> scenarios;
+        for (auto deployment : { "loose", "mapped", "pack" })
+        {
+            bool packed = std::string(deployment) == "pack";
+            MapFiles    = std::string(deployment) == "mapped";
+            auto files  = packed ? std::vector<std::string>{ archive } : looseFiles;
+            auto mount  = [&] () -> std::unique_ptr<Gx::IFileSystem>
+            {
+                if (packed)
+                    return std::make_unique<Gx::PackFileSystem>(archive);
+
+                auto local = std::make_unique<Gx::LocalFileSystem>(tree);
+                local->UseMemoryMapping(MapFiles);
+
+                return local;
+            };
+
+            for (auto cache : { "warm", "cold", "prefetch" })
+            {
+                for (auto execution : { "sequential", "parallel", "batch" })
+                {
+                    // Batch reads are a LocalFileSystem feature, archives are already served from memory
+                    if (packed && std::string(execution) == "batch")
+                        continue;
+
+                    auto scenario = Run(options, names, files, deployment, mount, cache, execution);
+                    std::cerr << std::left << std::setw(7) << scenario.Deployment << std::setw(9) << scenario.Cache << std::setw(11) << scenario.Execution;
+                    if (scenario.Skipped)
+                        std::cerr << "skipped (page cache cannot be dropped)" << std::endl;
+                    else
+                        std::cerr << std::right << std::fixed << std::setprecision(3) << std::setw(9) << scenario.WallSeconds << " s" << std::endl;
+
+                    scenarios.push_back(scenario);
+                }
+            }
+        }
+
+        if (options.Output.empty())
+            WriteJson(std::cout, options, totalBytes, scenarios);
+        else
+        {
+            std::ofstream output(options.Output);
+            WriteJson(output, options, totalBytes, scenarios);
+        }
+
+        if (!options.Keep)
+            std::filesystem::remove_all(options.Root);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace Bench
+{
+    namespace
+    {
+        volatile std::uintptr_t Sink;
+
+        std::string Escape(const std::string &value)
+        {
+            std::string escaped;
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    escaped += '\\';
+
+                escaped += c;
+            }
+
+            return escaped;
+        }
+
+        void WriteJson(std::ostream &output, const std::vector<Result> &results)
+        {
+            output << "{\n  \"benchmarks\": [";
+            for (std::size_t i = 0; i < results.size(); i++)
+            {
+                auto &result = results[i];
+                output << (i == 0 ? "\n" : ",\n")
+                       << "    {\"name\": \"" << Escape(result.Name) << "\", "
+                       << "\"param\": \"" << Escape(result.Param) << "\", "
+                       << "\"operations\": " << result.Operations << ", "
+                       << std::fixed << std::setprecision(3)
+                       << "\"best_ns_per_op\": " << result.BestNsPerOp << ", "
+                       << "\"median_ns_per_op\": " << result.MedianNsPerOp << "}";
+            }
+
+            output << "\n  ]\n}\n";
+        }
+    }
+
+    void Keep(const void *value)
+    {
+        Sink = reinterpret_cast<std::uintptr_t>(value);
+    }
+
+    void Keep(std::uint64_t value)
+    {
+        Sink = static_cast<std::uintptr_t>(value);
+    }
+
+    void Runner::Add(Benchmark benchmark)
+    {
+        m_benchmarks.push_back(std::move(benchmark));
+    }
+
+    int Runner::Run(int argc, char *argv[])
+    {
+        std::string output;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            if (arg == "--filter" && i + 1 < argc)
+                m_filter = argv[++i];
+            else if (arg == "--output" && i + 1 < argc)
+                output = argv[++i];
+            else if (arg == "--repetitions" && i + 1 < argc)
+                m_repetitions = std::max(1, std::stoi(argv[++i]));
+            else if (arg == "--quick")
+                m_quick = true;
+            else
+            {
+                std::cerr << "Usage: Genode.IO.Bench [--filter <substring>] [--output <file.json>] [--repetitions <n>] [--quick]" << std::endl;
+                return 1;
+            }
+        }
+
+        for (auto &benchmark : m_benchmarks)
+            benchmark(*this);
+
+        if (output.empty())
+        {
+            WriteJson(std::cout, m_results);
+            return 0;
+        }
+
+        std::ofstream file(output);
+        if (!file)
+        {
+            std::cerr << "Failed to write [" << output << "]" << std::endl;
+            return 1;
+        }
+
+        WriteJson(file, m_results);
+        return 0;
+    }
+
+    void Runner::Measure(const std::string &name, const std::string &param, std::uint64_t operations, const Body &body)
+    {
+        if (!m_filter.empty() && (name + "/" + param).find(m_filter) == std::string::npos)
+            return;
+
+        std::vector<double> samples;
+        for (std::size_t i = 0; i < m_repetitions; i++)
+        {
+            Timer timer;
+            body(timer);
+
+            auto ns = std::chrono::duration<double, std::nano>(timer.GetElapsed()).count();
+            samples.push_back(ns / static_cast<double>(std::max<std::uint64_t>(operations, 1)));
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.Name          = name;
+        result.Param         = param;
+        result.Operations    = operations;
+        result.BestNsPerOp   = samples.front();
+        result.MedianNsPerOp = samples[samples.size() / 2];
+        m_results.push_back(result);
+
+        std::cerr << std::left << std::setw(48) << name << std::setw(20) << param
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(12) << result.MedianNsPerOp << " ns/op" << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Bench::Runner runner;
+    Bench::RegisterContainerBenchmarks(runner);
+    Bench::RegisterManagerBenchmarks(runner);
+    Bench::RegisterLoaderFactoryBenchmarks(runner);
+    Bench::RegisterFileSystemBenchmarks(runner);
+    Bench::RegisterConcurrentContainerBenchmarks(runner);
+
+    return runner.Run(argc, argv);
+}
@@ -0,0 +1,76 @@
+#ifndef GENODE_BENCH_HPP
+#define GENODE_BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    /// Measures the portion of a repetition that belongs to the benchmark, setup and teardown are excluded.
+    class Timer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void Start() { m_start = Clock::now(); }
+        void Stop()  { m_elapsed += Clock::now() - m_start; }
+
+        Clock::duration GetElapsed() const { return m_elapsed; }
+
+    private:
+        Clock::time_point m_start;
+        Clock::duration   m_elapsed = {};
+    };
+
+    struct Result
+    {
+        std::string   Name;
+        std::string   Param;
+        std::uint64_t Operations   = 0;
+        double        BestNsPerOp   = 0;
+        double        MedianNsPerOp = 0;
+    };
+
+    /// Runs registered benchmarks and reports the results as JSON.
+    class Runner
+    {
+    public:
+        using Benchmark = std::function<void(Runner&)>;
+        using Body      = std::function<void(Timer&)>;
+
+        void Add(Benchmark benchmark);
+        int Run(int argc, char *argv[]);
+
+        /// Run given \p body for each repetition and record the time per operation.
+        /// \param name Name of the benchmark.
+        /// \param param Parameters of the benchmark, e.g. "entries=1000".
+        /// \param operations The number of operations performed by a single call of body.
+        /// \param body Function that perform the operations, the measured portion must be enclosed by Timer::Start and Timer::Stop.
+        void Measure(const std::string &name, const std::string &param, std::uint64_t operations, const Body &body);
+
+        /// Gets a value indicating whether the benchmarks should run with reduced sizes, e.g. in CI smoke runs.
+        bool IsQuick() const { return m_quick; }
+
+    private:
+        std::vector<Benchmark> m_benchmarks;
+        std::vector<Result>    m_results;
+        std::string            m_filter;
+        std::size_t            m_repetitions = 5;
+        bool                   m_quick       = false;
+    };
+
+    /// Prevent the compiler from discarding the computation that produce given value.
+    void Keep(const void *value);
+    void Keep(std::uint64_t value);
+
+    void RegisterContainerBenchmarks(Runner &runner);
+    void RegisterManagerBenchmarks(Runner &runner);
+    void RegisterLoaderFactoryBenchmarks(Runner &runner);
+    void RegisterFileSystemBenchmarks(Runner &runner);
+    void RegisterConcurrentContainerBenchmarks(Runner &runner);
+}
+
+#endif //GENODE_BENCH_HPP
@@ -0,0 +1,177 @@
+#include "Bench.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include <Genode/IO/ConcurrentResourceContainer.hpp>
+#include <Genode/IO/ResourceManager.hpp>
+
+namespace Bench
+{
+    namespace
+    {
+        struct Blob
+        {
+            std::uint64_t Value;
+        };
+
+        constexpr std::size_t EntryCount = 4096;
+        constexpr std::size_t MaxThreads = 16;
+
+        std::vector<std::string> CreateIDs(std::size_t count)
+        {
+            std::vector<std::string> ids;
+            ids.reserve(count);
+            for (std::size_t i = 0; i < count; i++)
+                ids.push_back("textures/level" + std::to_string(i % 97) + "/sprite_" + std::to_string(i) + ".png");
+
+            return ids;
+        }
+
+        // Readers verify the value of every resource they observe, a replaced or destroyed resource that is freed
+        // too early shows up as a corrupted value (or as a use-after-free under sanitizers)
+        std::unique_ptr<Blob> CreateBlob(const std::string &id)
+        {
+            return std::make_unique<Blob>(Blob{ Gx::ResourceID::Hash(id) });
+        }
+
+        void Verify(const Blob *blob, const std::string &id)
+        {
+            if (blob && blob->Value != Gx::ResourceID::Hash(id))
+            {
+                std::cerr << "ConcurrentResourceContainer returned a corrupted resource for [" << id << "]" << std::endl;
+                std::abort();
+            }
+        }
+
+        /// Run \p work on given number of threads at once, only the concurrent section is measured.
+        template<class Work>
+        void RunThreads(Timer &timer, std::size_t threadCount, const Work &work)
+        {
+            std::atomic<bool>        start = false;
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < threadCount; i++)
+            {
+                threads.emplace_back([&, i] {
+                    while (!start.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+
+                    work(i);
+                });
+            }
+
+            timer.Start();
+            start.store(true, std::memory_order_release);
+            for (auto &thread : threads)
+                thread.join();
+            timer.Stop();
+        }
+
+        void RunScaling(Runner &runner, const std::vector<std::string> &ids, std::size_t lookups)
+        {
+            Gx::ConcurrentResourceContainer<Blob> container;
+            for (auto &id : ids)
+                container.Store(id, CreateBlob(id));
+
+            Gx::ResourceManager manager;
+            for (auto &id : ids)
+                manager.AddFromDeserializer<Blob>(id, [&id] { return CreateBlob(id); });
+
+            for (std::size_t threads = 1; threads <= MaxThreads; threads *= 2)
+            {
+                auto param = "threads=" + std::to_string(threads);
+                runner.Measure("ConcurrentResourceContainer/Find", param, threads * lookups, [&] (Timer &timer) {
+                    RunThreads(timer, threads, [&] (std::size_t index) {
+                        for (std::size_t i = 0; i < lookups; i++)
+                        {
+                            auto &id = ids[(i * 7 + index * 131) % ids.size()];
+                            Keep(container.Find(id).Get());
+                        }
+                    });
+                });
+
+                runner.Measure("ConcurrentResourceContainer/Mixed", param, threads * lookups, [&] (Timer &timer) {
+                    RunThreads(timer, threads, [&] (std::size_t index) {
+                        for (std::size_t i = 0; i < lookups; i++)
+                        {
+                            auto &id = ids[(i * 7 + index * 131) % ids.size()];
+                            if (i % 16 == 0)
+                                container.Store(id, CreateBlob(id));
+                            else
+                                Keep(container.Find(id).Get());
+                        }
+                    });
+                });
+
+                // Baseline: ResourceManager serializes lookups through a single reader-writer lock
+                runner.Measure("ResourceManager/FindShared", param, threads * lookups, [&] (Timer &timer) {
+                    RunThreads(timer, threads, [&] (std::size_t index) {
+                        for (std::size_t i = 0; i < lookups; i++)
+                        {
+                            auto &id = ids[(i * 7 + index * 131) % ids.size()];
+                            Keep(manager.Find<Blob>(id));
+                        }
+                    });
+                });
+            }
+        }
+
+        void RunStress(Runner &runner, const std::vector<std::string> &ids, std::size_t operations)
+        {
+            constexpr std::size_t writers = 4;
+            constexpr std::size_t readers = MaxThreads - writers;
+
+            runner.Measure("ConcurrentResourceContainer/Stress", "readers=" + std::to_string(readers) + ",writers=" + std::to_string(writers), MaxThreads * operations, [&] (Timer &timer) {
+                Gx::ConcurrentResourceContainer<Blob> container;
+                for (std::size_t i = 0; i < ids.size(); i += 2)
+                    container.Store(ids[i], CreateBlob(ids[i]));
+
+                RunThreads(timer, MaxThreads, [&] (std::size_t index) {
+                    std::mt19937 random(static_cast<unsigned>(index));
+                    std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+
+                    for (std::size_t i = 0; i < operations; i++)
+                    {
+                        auto &id = ids[pick(random)];
+                        if (index >= readers)
+                        {
+                            auto action = random() % 64;
+                            if (action == 0)
+                                container.Clear();
+                            else if (action < 16)
+                                container.Destroy(id);
+                            else
+                                Verify(container.Store(id, CreateBlob(id)).Get(), id);
+
+                            continue;
+                        }
+
+                        // Hold the reference across other lookups to widen the window in which it could be reclaimed
+                        auto reference = container.Find(id);
+                        for (std::size_t j = 0; j < 4; j++)
+                        {
+                            auto &other = ids[pick(random)];
+                            Verify(container.Find(other).Get(), other);
+                        }
+
+                        Verify(reference.Get(), id);
+                    }
+                });
+
+                Gx::Epoch::Collect();
+            });
+        }
+    }
+
+    void RegisterConcurrentContainerBenchmarks(Runner &runner)
+    {
+        runner.Add([] (Runner &runner) {
+            auto ids = CreateIDs(EntryCount);
+            RunScaling(runner, ids, runner.IsQuick() ? 20000 : 500000);
+            RunStress(runner, ids, runner.IsQuick() ? 5000 : 100000);
+        });
+    }
+}
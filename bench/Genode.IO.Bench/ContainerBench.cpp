@@ -0,0 +1,92 @@
+#include "Bench.hpp"
+
+#include <Genode/IO/ResourceContainer.hpp>
+
+namespace Bench
+{
+    namespace
+    {
+        struct Blob
+        {
+            std::uint64_t Value;
+        };
+
+        std::vector<std::string> CreateIDs(std::size_t count)
+        {
+            std::vector<std::string> ids;
+            ids.reserve(count);
+            for (std::size_t i = 0; i < count; i++)
+                ids.push_back("textures/level" + std::to_string(i % 97) + "/sprite_" + std::to_string(i) + ".png");
+
+            return ids;
+        }
+
+        void Fill(Gx::ResourceContainer<Blob> &container, const std::vector<std::string> &ids)
+        {
+            for (std::size_t i = 0; i < ids.size(); i++)
+                container.Store(ids[i], std::make_unique<Blob>(Blob{ i }));
+        }
+
+        void Run(Runner &runner, std::size_t count)
+        {
+            auto ids   = CreateIDs(count);
+            auto param = "entries=" + std::to_string(count);
+
+            runner.Measure("ResourceContainer/Store", param, count, [&] (Timer &timer) {
+                Gx::ResourceContainer<Blob> container;
+
+                timer.Start();
+                Fill(container, ids);
+                timer.Stop();
+            });
+
+            Gx::ResourceContainer<Blob> container;
+            Fill(container, ids);
+
+            runner.Measure("ResourceContainer/Find", param, count, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &id : ids)
+                    Keep(container.Find(id));
+                timer.Stop();
+            });
+
+            std::vector<Gx::ResourceHandle<Blob>> handles;
+            handles.reserve(count);
+            for (auto &id : ids)
+                handles.push_back(container.GetHandle(id));
+
+            runner.Measure("ResourceContainer/FindHandle", param, count, [&] (Timer &timer) {
+                timer.Start();
+                for (auto handle : handles)
+                    Keep(container.Find(handle));
+                timer.Stop();
+            });
+
+            runner.Measure("ResourceContainer/FindMissing", param, count, [&] (Timer &timer) {
+                timer.Start();
+                for (std::size_t i = 0; i < count; i++)
+                    Keep(container.Find("missing"));
+                timer.Stop();
+            });
+
+            runner.Measure("ResourceContainer/Destroy", param, count, [&] (Timer &timer) {
+                Gx::ResourceContainer<Blob> target;
+                Fill(target, ids);
+
+                timer.Start();
+                for (auto &id : ids)
+                    Keep(target.Destroy(id));
+                timer.Stop();
+            });
+        }
+    }
+
+    void RegisterContainerBenchmarks(Runner &runner)
+    {
+        runner.Add([] (Runner &runner) {
+            std::size_t limit = runner.IsQuick() ? 10000 : 1000000;
+            for (std::size_t count = 1000; count <= limit; count *= 10)
+                Run(runner, count);
+        });
+    }
+}
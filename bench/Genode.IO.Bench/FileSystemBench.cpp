@@ -0,0 +1,123 @@
+#include "Bench.hpp"
+
+#include <cstring>
+#include <map>
+
+#include <SFML/System/MemoryInputStream.hpp>
+
+#include <Genode/IO/FileSystem.hpp>
+
+namespace Bench
+{
+    namespace
+    {
+        /// Headless FileSystem that serve synthetic files from memory.
+        class MemoryFileSystem : public Gx::IFileSystem
+        {
+        public:
+            explicit MemoryFileSystem(std::map<std::string, std::string> files) : m_files(std::move(files)) {}
+
+            bool IsExists(const std::string &fileName) const override
+            {
+                return m_files.find(fileName) != m_files.end();
+            }
+
+            std::unique_ptr<sf::InputStream> Open(const std::string &fileName) override
+            {
+                auto it = m_files.find(fileName);
+                if (it == m_files.end())
+                    return nullptr;
+
+                auto stream = std::make_unique<sf::MemoryInputStream>();
+                stream->open(it->second.data(), it->second.size());
+
+                return stream;
+            }
+
+            std::size_t Read(const std::string &fileName, void *data) override
+            {
+                return Read(fileName, data, 0);
+            }
+
+            std::size_t Read(const std::string &fileName, void *data, std::size_t size) override
+            {
+                auto it = m_files.find(fileName);
+                if (it == m_files.end())
+                    return -1;
+
+                auto count = size == 0 ? it->second.size() : std::min(size, it->second.size());
+                std::memcpy(data, it->second.data(), count);
+
+                return count;
+            }
+
+            std::size_t GetFileSize(const std::string &fileName) override
+            {
+                auto it = m_files.find(fileName);
+                return it == m_files.end() ? -1 : it->second.size();
+            }
+
+        private:
+            std::map<std::string, std::string> m_files;
+        };
+
+        constexpr std::size_t FileCount = 1024;
+        constexpr std::size_t FileSize  = 256;
+
+        void Run(Runner &runner, std::size_t mounts)
+        {
+            // Files are placed in the lowest priority mount so resolution has to skip the other mounts
+            std::vector<std::string> names;
+            std::map<std::string, std::string> files;
+            for (std::size_t i = 0; i < FileCount; i++)
+            {
+                names.push_back("bench/data/file" + std::to_string(i) + ".bin");
+                files.emplace(names.back(), std::string(FileSize, static_cast<char>(i)));
+            }
+
+            Gx::FileSystem::Mount(std::make_unique<MemoryFileSystem>(std::move(files)), 1);
+            for (std::size_t i = 1; i < mounts; i++)
+                Gx::FileSystem::Mount(std::make_unique<MemoryFileSystem>(std::map<std::string, std::string>()), 2);
+
+            auto param = "mounts=" + std::to_string(mounts);
+            runner.Measure("FileSystem/IsExists", param, FileCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &name : names)
+                    Keep(Gx::FileSystem::IsExists(name));
+                timer.Stop();
+            });
+
+            runner.Measure("FileSystem/IsExists(Missing)", param, FileCount, [&] (Timer &timer) {
+                timer.Start();
+                for (std::size_t i = 0; i < FileCount; i++)
+                    Keep(Gx::FileSystem::IsExists("bench/missing.bin"));
+                timer.Stop();
+            });
+
+            runner.Measure("FileSystem/Open", param, FileCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &name : names)
+                    Keep(Gx::FileSystem::Open(name).get());
+                timer.Stop();
+            });
+
+            std::vector<char> buffer(FileSize);
+            runner.Measure("FileSystem/Read", param, FileCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &name : names)
+                    Keep(Gx::FileSystem::Read(name, buffer.data(), buffer.size()));
+                timer.Stop();
+            });
+
+            Gx::FileSystem::Dismount<MemoryFileSystem>();
+        }
+    }
+
+    void RegisterFileSystemBenchmarks(Runner &runner)
+    {
+        runner.Add([] (Runner &runner) {
+            for (std::size_t mounts = 1; mounts <= 8; mounts *= 2)
+                Run(runner, mounts);
+        });
+    }
+}
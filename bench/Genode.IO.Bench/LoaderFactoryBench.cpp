@@ -0,0 +1,52 @@
+#include "Bench.hpp"
+
+#include <Genode/IO/ResourceLoaderFactory.hpp>
+
+namespace Bench
+{
+    namespace
+    {
+        struct Blob
+        {
+            std::uint64_t Value;
+        };
+
+        class BlobLoader : public Gx::IResourceLoader<Blob>
+        {
+        public:
+            std::unique_ptr<Blob> LoadFromFile(const std::string &, const Gx::ResourceContext &) override { return std::make_unique<Blob>(); }
+            std::unique_ptr<Blob> LoadFromMemory(void *, std::size_t, const Gx::ResourceContext &) override { return std::make_unique<Blob>(); }
+            std::unique_ptr<Blob> LoadFromStream(sf::InputStream &, const Gx::ResourceContext &) override { return std::make_unique<Blob>(); }
+
+        private:
+            std::vector<unsigned char> m_scratch = std::vector<unsigned char>(4096);
+        };
+
+        constexpr std::uint64_t Iterations = 100000;
+    }
+
+    void RegisterLoaderFactoryBenchmarks(Runner &runner)
+    {
+        runner.Add([] (Runner &runner) {
+            Gx::ResourceLoaderFactory::Register<Blob, BlobLoader>();
+
+            runner.Measure("ResourceLoaderFactory/CreateResourceLoaderFor", "", Iterations, [] (Timer &timer) {
+                timer.Start();
+                for (std::uint64_t i = 0; i < Iterations; i++)
+                    Keep(Gx::ResourceLoaderFactory::CreateResourceLoaderFor<Blob>().get());
+                timer.Stop();
+            });
+
+            Gx::ResourceLoaderFactory::UseCachedLoaders(true);
+            runner.Measure("ResourceLoaderFactory/AcquireResourceLoaderFor", "cached", Iterations, [] (Timer &timer) {
+                timer.Start();
+                for (std::uint64_t i = 0; i < Iterations; i++)
+                    Keep(Gx::ResourceLoaderFactory::AcquireResourceLoaderFor<Blob>().get());
+                timer.Stop();
+            });
+
+            Gx::ResourceLoaderFactory::UseCachedLoaders(false);
+            Gx::ResourceLoaderFactory::Remove<Blob>();
+        });
+    }
+}
@@ -0,0 +1,87 @@
+#include "Bench.hpp"
+
+#include <utility>
+
+#include <Genode/IO/ResourceManager.hpp>
+
+namespace Bench
+{
+    namespace
+    {
+        template<std::size_t N>
+        struct Synthetic
+        {
+            std::uint64_t Value;
+        };
+
+        constexpr std::size_t TypeCount  = 64;
+        constexpr std::size_t EntryCount = 256;
+
+        template<std::size_t N>
+        void Populate(Gx::ResourceManager &manager)
+        {
+            for (std::size_t i = 0; i < EntryCount; i++)
+            {
+                manager.AddFromDeserializer<Synthetic<N>>("entry" + std::to_string(i), [i] () {
+                    return std::make_unique<Synthetic<N>>(Synthetic<N>{ i });
+                });
+            }
+        }
+
+        template<std::size_t... N>
+        void PopulateAll(Gx::ResourceManager &manager, std::index_sequence<N...>)
+        {
+            (Populate<N>(manager), ...);
+        }
+
+        template<std::size_t... N>
+        void FindAll(const Gx::ResourceManager &manager, const Gx::ResourceID &id, std::index_sequence<N...>)
+        {
+            (Keep(manager.Find<Synthetic<N>>(id)), ...);
+        }
+    }
+
+    void RegisterManagerBenchmarks(Runner &runner)
+    {
+        runner.Add([] (Runner &runner) {
+            auto types = std::make_index_sequence<TypeCount>();
+
+            Gx::ResourceManager manager;
+            PopulateAll(manager, types);
+
+            std::vector<std::string> ids;
+            for (std::size_t i = 0; i < EntryCount; i++)
+                ids.push_back("entry" + std::to_string(i));
+
+            auto param = "types=" + std::to_string(TypeCount);
+            runner.Measure("ResourceManager/Find", param, TypeCount * EntryCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &id : ids)
+                    FindAll(manager, id, types);
+                timer.Stop();
+            });
+
+            std::vector<Gx::ResourceHandle<Synthetic<0>>> handles;
+            for (auto &id : ids)
+                handles.push_back(manager.GetHandle<Synthetic<0>>(id));
+
+            runner.Measure("ResourceManager/FindHandle", param, EntryCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto handle : handles)
+                    Keep(manager.Find(handle));
+                timer.Stop();
+            });
+
+            runner.Measure("ResourceManager/AddFromDeserializer(Reuse)", param, EntryCount, [&] (Timer &timer) {
+                timer.Start();
+                for (auto &id : ids)
+                {
+                    Keep(&manager.AddFromDeserializer<Synthetic<1>>(id, [] () {
+                        return std::make_unique<Synthetic<1>>();
+                    }, Gx::CacheMode::Reuse));
+                }
+                timer.Stop();
+            });
+        });
+    }
+}
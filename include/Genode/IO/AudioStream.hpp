@@ -0,0 +1,64 @@
+#ifndef GENODE_AUDIO_STREAM_HPP
+#define GENODE_AUDIO_STREAM_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SFML/Audio/Music.hpp>
+
+namespace Gx
+{
+    /// Represents an audio that decoded in chunks while it is being played, instead of being decoded entirely upfront like sf::SoundBuffer.
+    ///
+    /// \remark
+    /// Unlike sf::Music, AudioStream owns its source: files that are not located in the disk (e.g. packed archive) are streamed
+    /// through the stream opened by FileSystem, and the stream is kept open for as long as the AudioStream is alive.
+    /// Only the compressed source and a few chunks of decoded samples are held in memory.
+    class AudioStream : public sf::Music
+    {
+    public:
+        /// Initializes a new instance of AudioStream.
+        AudioStream();
+
+        /// Stop the playback and releases the source of AudioStream.
+        ~AudioStream() override;
+
+        /// Open the audio from a file through the mounted FileSystem.
+        /// \param fileName Path of the audio file.
+        /// \return true if the audio is successfully opened; otherwise, false.
+        bool OpenFromFile(const std::string &fileName);
+
+        /// Open the audio from a copy of given memory.
+        /// \param data Pointer to the file data in memory.
+        /// \param size Size of the data to load, in bytes.
+        /// \return true if the audio is successfully opened; otherwise, false.
+        bool OpenFromMemory(const void *data, std::size_t size);
+
+        /// Open the audio from given file data and take the ownership of the data.
+        /// \param data File data to decode the audio from.
+        /// \return true if the audio is successfully opened; otherwise, false.
+        bool OpenFromMemory(std::vector<char> data);
+
+        /// Open the audio from given stream and take the ownership of the stream.
+        /// \param stream Stream to decode the audio from.
+        /// \return true if the audio is successfully opened; otherwise, false.
+        bool OpenFromStream(std::unique_ptr<sf::InputStream> stream);
+
+        /// Gets the size of the source that held in memory by this instance of AudioStream.
+        /// \return Size of the source in bytes, zero if the source is streamed from a file.
+        std::size_t GetSourceSize() const;
+
+        /// Gets the size of the decoded samples that buffered by this instance of AudioStream.
+        /// \return Estimated size of the decoded samples in bytes.
+        std::size_t GetBufferSize() const;
+
+    private:
+        void Close();
+
+        std::unique_ptr<sf::InputStream> m_stream;
+        std::vector<char>                m_data;
+    };
+}
+
+#endif //GENODE_AUDIO_STREAM_HPP
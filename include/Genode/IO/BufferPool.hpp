@@ -0,0 +1,119 @@
+#ifndef GENODE_BUFFER_POOL_HPP
+#define GENODE_BUFFER_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Provides buffers of power of two size classes and recycles their memory once they are released.
+    ///
+    /// \remark
+    /// Loading a level reads hundreds of files of similar sizes, the pool keeps the released buffers
+    /// so subsequent reads reuse them instead of allocating and freeing memory for each file.
+    /// Buffers that larger than MaxPooledSize are allocated and freed directly.
+    /// The pool is safe to use from multiple threads and must outlive the buffers that it provides.
+    class BufferPool final : private NonCopyable
+    {
+    public:
+        /// Size of the smallest size class, in bytes.
+        static constexpr std::size_t MinPooledSize = 4 * 1024;
+
+        /// Size of the largest size class, in bytes.
+        static constexpr std::size_t MaxPooledSize = 64 * 1024 * 1024;
+
+        /// Default maximum size of the memory kept by the pool, in bytes.
+        static constexpr std::size_t DefaultRetention = 64 * 1024 * 1024;
+
+        /// Represents a move-only buffer that is returned to its BufferPool when it is destroyed.
+        class Buffer
+        {
+        public:
+            /// Initializes an invalid instance of Buffer.
+            Buffer() = default;
+            Buffer(Buffer &&other) noexcept;
+            Buffer &operator=(Buffer &&other) noexcept;
+            ~Buffer();
+
+            /// Gets pointer to the buffer data.
+            /// \return Pointer to the first byte, nullptr if the buffer is empty.
+            unsigned char *GetData() const { return m_data; }
+
+            /// Gets the size of the buffer data.
+            /// \return Size of the buffer data, in bytes.
+            std::size_t GetSize() const { return m_size; }
+
+            /// Gets the size of the allocated memory, which is at least the size of the buffer data.
+            /// \return Size of the allocated memory, in bytes.
+            std::size_t GetCapacity() const { return m_capacity; }
+
+            /// Shrink the size of the buffer data without reallocating it, e.g. when fewer bytes than expected are read.
+            /// \param size New size of the buffer data, in bytes. Must not exceed the current size.
+            void Shrink(std::size_t size);
+
+            /// Return the memory to the BufferPool and invalidate this instance of Buffer.
+            void Release();
+
+            /// Gets a value indicating whether the buffer is valid, a valid buffer may be empty.
+            explicit operator bool() const { return m_valid; }
+
+        private:
+            friend class BufferPool;
+
+            Buffer(BufferPool *pool, unsigned char *data, std::size_t size, std::size_t capacity);
+
+            BufferPool    *m_pool     = nullptr;
+            unsigned char *m_data     = nullptr;
+            std::size_t    m_size     = 0;
+            std::size_t    m_capacity = 0;
+            bool           m_valid    = false;
+        };
+
+        /// Initializes a new instance of BufferPool.
+        /// \param retention Maximum size of the released memory that kept by the pool, in bytes.
+        explicit BufferPool(std::size_t retention = DefaultRetention);
+
+        /// Frees the memory kept by the pool.
+        ~BufferPool();
+
+        /// Gets the pool that used by FileSystem::ReadAll.
+        static BufferPool &GetDefault();
+
+        /// Acquire a buffer of given \p size.
+        /// \param size Size of the buffer data, in bytes.
+        /// \return A valid Buffer of given size.
+        Buffer Acquire(std::size_t size);
+
+        /// Gets the size of the released memory that kept by the pool.
+        /// \return Size of the kept memory, in bytes.
+        std::size_t GetRetainedSize() const;
+
+        /// Free the memory kept by the pool.
+        void Trim();
+
+    private:
+        static constexpr std::size_t ClassCount = 15;
+        static_assert((MinPooledSize << (ClassCount - 1)) == MaxPooledSize, "Size classes must cover the pooled sizes");
+
+        struct SizeClass
+        {
+            std::mutex                  Mutex;
+            std::vector<unsigned char*> Blocks;
+        };
+
+        static std::size_t GetClassIndex(std::size_t size);
+
+        void Recycle(unsigned char *data, std::size_t capacity);
+
+        std::array<SizeClass, ClassCount> m_classes;
+        std::atomic<std::size_t>          m_retained;
+        std::size_t                       m_retention;
+    };
+}
+
+#endif //GENODE_BUFFER_POOL_HPP
@@ -0,0 +1,162 @@
+#ifndef GENODE_CONCURRENT_RESOURCE_CONTAINER_HPP
+#define GENODE_CONCURRENT_RESOURCE_CONTAINER_HPP
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Genode/IO/ResourceContainer.hpp>
+#include <Genode/IO/ResourceID.hpp>
+#include <Genode/System/Epoch.hpp>
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Provides central point to store, access and destroy a particular type of resources from multiple threads.
+    ///
+    /// \remark
+    /// Resources are distributed into shards by the hash of their ID. Lookups never lock, they traverse immutable
+    /// bucket chains that writers replace atomically, while writers only contend with the writers of the same shard.
+    /// Replaced and destroyed resources are reclaimed through Epoch, so a resource is never freed while a Reference to it is alive.
+    ///
+    /// Unlike ResourceContainer, this container does not support handles or eviction.
+    /// \tparam R Type of resources that stored inside ConcurrentResourceContainer.
+    template<class R>
+    class ConcurrentResourceContainer final : private NonCopyable
+    {
+    public:
+        static constexpr std::size_t ShardCount = 16;
+
+        /// Represents a resource that obtained from ConcurrentResourceContainer.
+        /// The resource is kept alive until the Reference is destroyed, even if it is destroyed or replaced in the meantime.
+        ///
+        /// \remark
+        /// Reference keeps the calling thread inside the epoch, it must be destroyed on the thread that obtain it
+        /// and should not be held longer than necessary since it delays the reclamation of every retired resource.
+        class Reference
+        {
+        public:
+            Reference() = default;
+            Reference(Reference &&other) noexcept;
+            Reference &operator=(Reference &&other) noexcept;
+            ~Reference();
+
+            /// Gets the referenced resource.
+            /// \return Pointer of the Resource, nullptr if the resource is not found.
+            R *Get() const { return m_resource; }
+
+            R &operator*() const { return *m_resource; }
+            R *operator->() const { return m_resource; }
+            explicit operator bool() const { return m_resource != nullptr; }
+
+        private:
+            friend class ConcurrentResourceContainer;
+
+            // The caller must have entered the epoch, the reference takes over the responsibility to leave it
+            explicit Reference(R *resource) : m_resource(resource), m_entered(true) {}
+
+            R   *m_resource = nullptr;
+            bool m_entered  = false;
+        };
+
+        /// Initializes a new instance of ConcurrentResourceContainer
+        ConcurrentResourceContainer();
+
+        /// Releases the resources inside the ConcurrentResourceContainer.
+        /// No other thread may access the container or hold a Reference during the destruction.
+        ~ConcurrentResourceContainer();
+
+        /// Store given resource that could be identified with given \p id to the ConcurrentResourceContainer
+        /// \param id Value to identify the given resource.
+        /// \param resource Resource to store inside container.
+        /// \param mode Specifies store mode to use when storing the resource into this instance of ConcurrentResourceContainer.
+        /// \return Reference to Resource that successfully stored into this instance of ConcurrentResourceContainer.
+        Reference Store(const ResourceID &id, std::unique_ptr<R> resource, CacheMode mode = CacheMode::Update);
+
+        /// Store resource to the ConcurrentResourceContainer by using given resource deserialization function in which the resulting resource could be identified with given \p id.
+        /// The deserializer is called without holding any lock, when multiple threads store the same ID concurrently, they may all deserialize the resource.
+        /// \param id Value to identify the resource that produced by deserializer.
+        /// \param deserializer Resource deserialization function which describe how resource get loaded.
+        /// \param mode Specifies store mode to use when storing the resource into this instance of ConcurrentResourceContainer.
+        /// \return Reference to Resource that successfully stored into this instance of ConcurrentResourceContainer.
+        Reference Store(const ResourceID &id, const std::function<std::unique_ptr<R>()> &deserializer, CacheMode mode = CacheMode::Reuse);
+
+        /// Destroy resource from this instance of ConcurrentResourceContainer.
+        /// \param resource Resource to destroy from this instance of ConcurrentResourceContainer.
+        /// \return true if resource is found and removed from this instance of ConcurrentResourceContainer; otherwise, false.
+        bool Destroy(const R &resource);
+
+        /// Destroy resource from this instance of ConcurrentResourceContainer.
+        /// \param id ID of Resource to destroy from this instance of ConcurrentResourceContainer.
+        /// \return true if resource is found and removed from this instance of ConcurrentResourceContainer; otherwise, false.
+        bool Destroy(const ResourceID &id);
+
+        /// Find resource that match with given \p id.
+        /// \param id ID of Resource to retrieve from this instance of ConcurrentResourceContainer.
+        /// \return Reference of Resource if there's resource that match with the given id; otherwise, an empty Reference.
+        Reference Find(const ResourceID &id) const;
+
+        /// Gets a value indicate whether there's a resource with id that match with given \p id inside this instance of ConcurrentResourceContainer.
+        /// \param id ID of Resource to check.
+        /// \return true if Resource is found; otherwise, false.
+        bool Contains(const ResourceID &id) const;
+
+        /// Gets the number of resources inside this instance of ConcurrentResourceContainer.
+        /// The result may be outdated when other threads are storing or destroying resources.
+        /// \return The number of resources inside this instance of ConcurrentResourceContainer
+        std::size_t Count() const;
+
+        /// Destroy all resources inside this instance of ConcurrentResourceContainer.
+        void Clear();
+
+    private:
+        static constexpr std::size_t InitialCapacity = 16;
+
+        struct Entry
+        {
+            std::unique_ptr<R> Resource;
+            std::string        ID;
+            std::uint64_t      Hash = 0;
+        };
+
+        // Nodes are immutable once published, writers replace the chain instead of modifying it
+        struct Node
+        {
+            Entry      *Value;
+            const Node *Next;
+        };
+
+        struct Table
+        {
+            explicit Table(std::size_t capacity);
+
+            std::size_t                                   Mask;
+            std::unique_ptr<std::atomic<const Node*>[]>   Buckets;
+        };
+
+        struct alignas(64) Shard
+        {
+            std::mutex               Mutex;
+            std::atomic<Table*>      Current = nullptr;
+            std::atomic<std::size_t> Count   = 0;
+        };
+
+        static std::size_t GetShardIndex(std::uint64_t hash);
+        static R *Lookup(const Table &table, const ResourceID &id);
+        static void RetireChain(const Node *begin, const Node *end);
+        static void DeleteTable(Table *table, bool entries);
+
+        Shard &GetShard(std::uint64_t hash) const;
+        void Replace(Table &table, std::size_t bucket, const Node *target, Entry *replacement);
+        void Grow(Shard &shard);
+
+        mutable std::array<Shard, ShardCount> m_shards;
+    };
+}
+
+#include <Genode/IO/ConcurrentResourceContainer.inl>
+#endif //GENODE_CONCURRENT_RESOURCE_CONTAINER_HPP
@@ -0,0 +1,333 @@
+#include <Genode/IO/Instrumentation.hpp>
+#include <Genode/IO/IOException.hpp>
+
+namespace Gx
+{
+    template<class R>
+    ConcurrentResourceContainer<R>::Reference::Reference(Reference &&other) noexcept :
+        m_resource(other.m_resource),
+        m_entered(other.m_entered)
+    {
+        other.m_resource = nullptr;
+        other.m_entered  = false;
+    }
+
+    template<class R>
+    typename ConcurrentResourceContainer<R>::Reference &ConcurrentResourceContainer<R>::Reference::operator=(Reference &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_entered)
+                Epoch::Leave();
+
+            m_resource       = other.m_resource;
+            m_entered        = other.m_entered;
+            other.m_resource = nullptr;
+            other.m_entered  = false;
+        }
+
+        return *this;
+    }
+
+    template<class R>
+    ConcurrentResourceContainer<R>::Reference::~Reference()
+    {
+        if (m_entered)
+            Epoch::Leave();
+    }
+
+    template<class R>
+    ConcurrentResourceContainer<R>::Table::Table(std::size_t capacity) :
+        Mask(capacity - 1),
+        Buckets(new std::atomic<const Node*>[capacity])
+    {
+        for (std::size_t i = 0; i < capacity; i++)
+            Buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    template<class R>
+    ConcurrentResourceContainer<R>::ConcurrentResourceContainer()
+    {
+        for (auto &shard : m_shards)
+            shard.Current.store(new Table(InitialCapacity), std::memory_order_release);
+    }
+
+    template<class R>
+    ConcurrentResourceContainer<R>::~ConcurrentResourceContainer()
+    {
+        for (auto &shard : m_shards)
+            DeleteTable(shard.Current.load(std::memory_order_acquire), true);
+    }
+
+    template<class R>
+    typename ConcurrentResourceContainer<R>::Reference ConcurrentResourceContainer<R>::Store(const ResourceID &id, std::unique_ptr<R> resource, CacheMode mode)
+    {
+        if (resource == nullptr)
+            throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Cannot store nullptr resource.");
+
+        auto hash   = id.GetHash();
+        auto &shard = GetShard(hash);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        auto table  = shard.Current.load(std::memory_order_relaxed);
+        auto bucket = hash & table->Mask;
+        for (auto node = table->Buckets[bucket].load(std::memory_order_relaxed); node; node = node->Next)
+        {
+            auto current = node->Value;
+            if (current->Hash != hash)
+                continue;
+            else if (current->ID != id.GetName())
+                throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource ID hash is collided with [" + current->ID + "].");
+            else if (mode == CacheMode::Allocate)
+                throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource with same ID is already exists.");
+
+            // Entries can't be retired while the shard is locked, so it is safe to enter the epoch after the lookup
+            if (mode == CacheMode::Reuse)
+            {
+                Epoch::Enter();
+                return Reference(current->Resource.get());
+            }
+
+            auto entry = std::make_unique<Entry>(Entry{ std::move(resource), current->ID, hash });
+            Replace(*table, bucket, node, entry.get());
+            Epoch::Retire(current);
+
+            Epoch::Enter();
+            return Reference(entry.release()->Resource.get());
+        }
+
+        if (shard.Count.load(std::memory_order_relaxed) > table->Mask)
+        {
+            Grow(shard);
+            table  = shard.Current.load(std::memory_order_relaxed);
+            bucket = hash & table->Mask;
+        }
+
+        auto entry = std::make_unique<Entry>(Entry{ std::move(resource), std::string(id.GetName()), hash });
+        auto node  = new Node{ entry.get(), table->Buckets[bucket].load(std::memory_order_relaxed) };
+        table->Buckets[bucket].store(node, std::memory_order_release);
+        shard.Count.fetch_add(1, std::memory_order_relaxed);
+
+        Epoch::Enter();
+        return Reference(entry.release()->Resource.get());
+    }
+
+    template<class R>
+    typename ConcurrentResourceContainer<R>::Reference ConcurrentResourceContainer<R>::Store(const ResourceID &id, const std::function<std::unique_ptr<R>()> &deserializer, CacheMode mode)
+    {
+        if (auto current = Find(id))
+        {
+            if (mode == CacheMode::Allocate)
+                throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource with same ID is already exists.");
+            else if (mode == CacheMode::Reuse)
+            {
+                Instrumentation::RecordLookup(typeid(R), id.GetName(), true);
+                return current;
+            }
+        }
+
+        Instrumentation::RecordLookup(typeid(R), id.GetName(), false);
+        auto start    = Instrumentation::Start();
+        auto resource = deserializer();
+        Instrumentation::RecordLoad(typeid(R), id.GetName(), start);
+
+        return Store(id, std::move(resource), mode);
+    }
+
+    template<class R>
+    bool ConcurrentResourceContainer<R>::Destroy(const R &resource)
+    {
+        for (auto &shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+
+            auto table = shard.Current.load(std::memory_order_relaxed);
+            for (std::size_t bucket = 0; bucket <= table->Mask; bucket++)
+            {
+                for (auto node = table->Buckets[bucket].load(std::memory_order_relaxed); node; node = node->Next)
+                {
+                    if (node->Value->Resource.get() != &resource)
+                        continue;
+
+                    auto entry = node->Value;
+                    Replace(*table, bucket, node, nullptr);
+                    shard.Count.fetch_sub(1, std::memory_order_relaxed);
+                    Epoch::Retire(entry);
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    template<class R>
+    bool ConcurrentResourceContainer<R>::Destroy(const ResourceID &id)
+    {
+        auto hash   = id.GetHash();
+        auto &shard = GetShard(hash);
+        std::lock_guard<std::mutex> lock(shard.Mutex);
+
+        auto table  = shard.Current.load(std::memory_order_relaxed);
+        auto bucket = hash & table->Mask;
+        for (auto node = table->Buckets[bucket].load(std::memory_order_relaxed); node; node = node->Next)
+        {
+            if (node->Value->Hash != hash || node->Value->ID != id.GetName())
+                continue;
+
+            auto entry = node->Value;
+            Replace(*table, bucket, node, nullptr);
+            shard.Count.fetch_sub(1, std::memory_order_relaxed);
+            Epoch::Retire(entry);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    template<class R>
+    typename ConcurrentResourceContainer<R>::Reference ConcurrentResourceContainer<R>::Find(const ResourceID &id) const
+    {
+        Epoch::Enter();
+
+        auto table    = GetShard(id.GetHash()).Current.load(std::memory_order_acquire);
+        auto resource = Lookup(*table, id);
+        if (!resource)
+        {
+            Epoch::Leave();
+            return {};
+        }
+
+        return Reference(resource);
+    }
+
+    template<class R>
+    bool ConcurrentResourceContainer<R>::Contains(const ResourceID &id) const
+    {
+        EpochGuard guard;
+        return Lookup(*GetShard(id.GetHash()).Current.load(std::memory_order_acquire), id) != nullptr;
+    }
+
+    template<class R>
+    std::size_t ConcurrentResourceContainer<R>::Count() const
+    {
+        std::size_t count = 0;
+        for (auto &shard : m_shards)
+            count += shard.Count.load(std::memory_order_relaxed);
+
+        return count;
+    }
+
+    template<class R>
+    void ConcurrentResourceContainer<R>::Clear()
+    {
+        for (auto &shard : m_shards)
+        {
+            auto table = std::make_unique<Table>(InitialCapacity);
+
+            std::lock_guard<std::mutex> lock(shard.Mutex);
+            auto current = shard.Current.exchange(table.release(), std::memory_order_acq_rel);
+            shard.Count.store(0, std::memory_order_relaxed);
+
+            Epoch::Retire(current, [] (void *ptr) { DeleteTable(static_cast<Table*>(ptr), true); });
+        }
+    }
+
+    template<class R>
+    std::size_t ConcurrentResourceContainer<R>::GetShardIndex(std::uint64_t hash)
+    {
+        // Buckets are indexed by the lower bits, so shards use the upper bits to keep both distributions independent
+        return static_cast<std::size_t>(hash >> 32) % ShardCount;
+    }
+
+    template<class R>
+    R *ConcurrentResourceContainer<R>::Lookup(const Table &table, const ResourceID &id)
+    {
+        auto hash = id.GetHash();
+        for (auto node = table.Buckets[hash & table.Mask].load(std::memory_order_acquire); node; node = node->Next)
+        {
+            if (node->Value->Hash == hash && node->Value->ID == id.GetName())
+                return node->Value->Resource.get();
+        }
+
+        return nullptr;
+    }
+
+    template<class R>
+    void ConcurrentResourceContainer<R>::RetireChain(const Node *begin, const Node *end)
+    {
+        while (begin != end)
+        {
+            auto next = begin->Next;
+            Epoch::Retire(begin);
+            begin = next;
+        }
+    }
+
+    template<class R>
+    void ConcurrentResourceContainer<R>::DeleteTable(Table *table, bool entries)
+    {
+        for (std::size_t bucket = 0; bucket <= table->Mask; bucket++)
+        {
+            auto node = table->Buckets[bucket].load(std::memory_order_relaxed);
+            while (node)
+            {
+                auto next = node->Next;
+                if (entries)
+                    delete node->Value;
+
+                delete node;
+                node = next;
+            }
+        }
+
+        delete table;
+    }
+
+    template<class R>
+    typename ConcurrentResourceContainer<R>::Shard &ConcurrentResourceContainer<R>::GetShard(std::uint64_t hash) const
+    {
+        return m_shards[GetShardIndex(hash)];
+    }
+
+    template<class R>
+    void ConcurrentResourceContainer<R>::Replace(Table &table, std::size_t bucket, const Node *target, Entry *replacement)
+    {
+        // Copy the nodes in front of the target, the nodes behind it are shared with the new chain
+        auto head   = table.Buckets[bucket].load(std::memory_order_relaxed);
+        auto suffix = replacement ? new Node{ replacement, target->Next } : target->Next;
+
+        std::vector<const Node*> prefix;
+        for (auto node = head; node != target; node = node->Next)
+            prefix.push_back(node);
+
+        for (auto it = prefix.rbegin(); it != prefix.rend(); ++it)
+            suffix = new Node{ (*it)->Value, suffix };
+
+        table.Buckets[bucket].store(suffix, std::memory_order_release);
+        RetireChain(head, target->Next);
+    }
+
+    template<class R>
+    void ConcurrentResourceContainer<R>::Grow(Shard &shard)
+    {
+        auto current  = shard.Current.load(std::memory_order_relaxed);
+        auto capacity = (current->Mask + 1) * 2;
+        auto table    = new Table(capacity);
+
+        for (std::size_t bucket = 0; bucket <= current->Mask; bucket++)
+        {
+            for (auto node = current->Buckets[bucket].load(std::memory_order_relaxed); node; node = node->Next)
+            {
+                auto &target = table->Buckets[node->Value->Hash & table->Mask];
+                target.store(new Node{ node->Value, target.load(std::memory_order_relaxed) }, std::memory_order_relaxed);
+            }
+        }
+
+        // Entries are moved into the new table, only the old nodes are released
+        shard.Current.store(table, std::memory_order_release);
+        Epoch::Retire(current, [] (void *ptr) { DeleteTable(static_cast<Table*>(ptr), false); });
+    }
+}
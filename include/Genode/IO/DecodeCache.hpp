@@ -0,0 +1,141 @@
+#ifndef GENODE_DECODE_CACHE_HPP
+#define GENODE_DECODE_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <Genode/IO/MappedFile.hpp>
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Represents an on-disk cache of decoded resource data, which allow loaders to skip the decoding of unchanged sources across runs.
+    ///
+    /// \remark
+    /// DecodeCache is disabled by default, call Enable to opt in. Entries are keyed by a hash of the source content, so renamed or
+    /// moved files still hit the cache while modified files miss it. Entries are memory-mapped when found, so the decoded data can be
+    /// passed to the graphics or audio device without an extra copy. The least recently used entries are removed when the total size
+    /// of the cache exceeds its capacity.
+    ///
+    /// TextureLoader caches 32-bit pixels and SoundBufferLoader caches 16-bit samples. The cache is safe to use from multiple threads.
+    class DecodeCache
+    {
+    public:
+        /// Default capacity of the cache, in bytes.
+        static constexpr std::size_t DefaultCapacity = 512 * 1024 * 1024;
+
+        /// Specifies the kind of decoded data.
+        enum class Format : std::uint32_t
+        {
+            /// 32-bit RGBA pixels.
+            Image   = 1,
+
+            /// Interleaved 16-bit signed samples.
+            Samples = 2
+        };
+
+        /// Describes the decoded data, only the properties that relevant to the Format are used.
+        struct Properties
+        {
+            std::uint32_t Width        = 0;
+            std::uint32_t Height       = 0;
+            std::uint32_t ChannelCount = 0;
+            std::uint32_t SampleRate   = 0;
+        };
+
+        /// Identifies the decoded data of a particular source.
+        struct Key
+        {
+            Format        Kind       = Format::Image;
+            std::uint64_t Hash       = 0;
+            std::uint64_t SourceSize = 0;
+        };
+
+        /// Represents a memory-mapped entry of DecodeCache.
+        class Entry final : private NonCopyable
+        {
+        public:
+            /// Gets the properties of the decoded data.
+            const Properties &GetProperties() const { return m_properties; }
+
+            /// Gets pointer to the decoded data.
+            const void *GetData() const { return m_file.GetData() + HeaderSize; }
+
+            /// Gets the size of the decoded data, in bytes.
+            std::size_t GetSize() const { return m_file.GetSize() - HeaderSize; }
+
+        private:
+            friend class DecodeCache;
+
+            Entry() = default;
+
+            MappedFile m_file;
+            Properties m_properties;
+        };
+
+        /// Enable the cache and store its entries inside given \p directory.
+        /// The directory is created if it does not exist, and trimmed to given \p capacity.
+        /// \param directory Path of the directory that hold cache entries.
+        /// \param capacity Maximum total size of cache entries, in bytes.
+        /// \return true if the cache is successfully enabled; otherwise, false.
+        static bool Enable(const std::string &directory, std::size_t capacity = DefaultCapacity);
+
+        /// Disable the cache, the stored entries are kept in the directory.
+        static void Disable();
+
+        /// Gets a value indicating whether the cache is enabled.
+        /// \return true if the cache is enabled; otherwise, false.
+        static bool IsEnabled();
+
+        /// Gets the total size of cache entries.
+        /// \return Total size of cache entries in bytes, zero if the cache is disabled.
+        static std::size_t GetSize();
+
+        /// Compute the hash of given source content.
+        /// \param data Pointer to the source content.
+        /// \param size Size of the source content, in bytes.
+        /// \return 64-bit hash of the source content.
+        static std::uint64_t Hash(const void *data, std::size_t size);
+
+        /// Create the Key that identify the decoded data of given source content.
+        /// \param format Format of the decoded data.
+        /// \param data Pointer to the source content.
+        /// \param size Size of the source content, in bytes.
+        /// \return Key of the decoded data.
+        static Key CreateKey(Format format, const void *data, std::size_t size);
+
+        /// Find and map the entry that match with given \p key, the entry is marked as recently used.
+        /// \param key Key of the decoded data.
+        /// \return Pointer of mapped Entry if exists; otherwise, nullptr.
+        static std::unique_ptr<Entry> Find(const Key &key);
+
+        /// Store decoded data under given \p key, existing entry with the same key is replaced.
+        /// Data that larger than a quarter of the capacity is not stored.
+        /// \param key Key of the decoded data.
+        /// \param properties Properties of the decoded data.
+        /// \param data Pointer to the decoded data.
+        /// \param size Size of the decoded data, in bytes.
+        /// \return true if the data is stored; otherwise, false.
+        static bool Store(const Key &key, const Properties &properties, const void *data, std::size_t size);
+
+        /// Remove the least recently used entries until the total size of the cache fits within its capacity.
+        static void Trim();
+
+    private:
+        static constexpr std::size_t HeaderSize = 64;
+
+        static std::string GetEntryName(const std::string &directory, const Key &key);
+        static void TrimLocked();
+
+        inline static std::mutex        m_mutex;
+        inline static std::atomic<bool> m_enabled  = false;
+        inline static std::string       m_directory;
+        inline static std::size_t       m_capacity = 0;
+        inline static std::size_t       m_size     = 0;
+    };
+}
+
+#endif //GENODE_DECODE_CACHE_HPP
@@ -0,0 +1,102 @@
+#ifndef GENODE_DEPENDENCY_GRAPH_HPP
+#define GENODE_DEPENDENCY_GRAPH_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Gx
+{
+    /// Represents the dependencies between resources, as acquired by the loaders through ResourceContext.
+    ///
+    /// \remark
+    /// Each node is identified by the type name and the ID of a resource, the file name is known when the resource is loaded from a file.
+    /// The graph can be saved into a manifest and loaded on later runs, so the resources can be loaded in dependency order before they are requested.
+    /// DependencyGraph is not thread-safe.
+    class DependencyGraph
+    {
+    public:
+        /// Represents a resource inside the graph.
+        struct Node
+        {
+            /// Name of the resource type, as given by std::type_info::name.
+            std::string Type;
+
+            /// ID of the resource.
+            std::string ID;
+
+            /// Path of the resource file, empty if the resource is not loaded from a file.
+            std::string FileName;
+
+            /// Nodes of the resources that this resource depends on.
+            std::vector<std::size_t> Dependencies;
+
+            /// Nodes of the resources that depend on this resource.
+            std::vector<std::size_t> Dependents;
+
+            /// Whether the resource is added directly rather than acquired as a dependency, it is not saved into the manifest.
+            bool Explicit = false;
+        };
+
+        /// Value that returned by Find when the node is not found.
+        static constexpr std::size_t NoNode = static_cast<std::size_t>(-1);
+
+        /// Find the node of given resource, or add it if the graph doesn't contain it yet.
+        /// \param type Name of the resource type.
+        /// \param id ID of the resource.
+        /// \return Index of the node.
+        std::size_t Insert(const std::string &type, const std::string &id);
+
+        /// Find the node of given resource.
+        /// \param type Name of the resource type.
+        /// \param id ID of the resource.
+        /// \return Index of the node if found; otherwise, NoNode.
+        std::size_t Find(const std::string &type, const std::string &id) const;
+
+        /// Add an edge from the \p dependent node to the \p dependency node.
+        /// \param dependent Index of the node that depends on the other node.
+        /// \param dependency Index of the node that the other node depends on.
+        /// \return true if the edge is added; otherwise, false if the edge already exists or both are the same node.
+        bool Connect(std::size_t dependent, std::size_t dependency);
+
+        /// Gets the node at given \p index.
+        Node &GetNode(std::size_t index);
+
+        /// Gets the node at given \p index.
+        const Node &GetNode(std::size_t index) const;
+
+        /// Gets the number of nodes inside the graph.
+        std::size_t GetNodeCount() const;
+
+        /// Sort the nodes so that every node comes after its dependencies.
+        /// \return Indices of the sorted nodes, nodes that are part of a dependency cycle (or depend on one) are omitted.
+        std::vector<std::size_t> Sort() const;
+
+        /// Save the graph into a manifest file.
+        /// \param fileName Path of the manifest file in the disk.
+        /// \return true if the manifest is saved; otherwise, false.
+        bool Save(const std::string &fileName) const;
+
+        /// Load a manifest file and merge it into the graph.
+        /// \param fileName Path of the manifest file in the disk.
+        /// \return true if the manifest is loaded; otherwise, false.
+        bool Load(const std::string &fileName);
+
+        /// Remove every node from the graph.
+        void Clear();
+
+    private:
+        using Key = std::pair<std::string, std::string>;
+        struct KeyHash
+        {
+            std::size_t operator()(const Key &key) const;
+        };
+
+        std::vector<Node>                             m_nodes;
+        std::unordered_map<Key, std::size_t, KeyHash> m_index;
+    };
+}
+
+#endif //GENODE_DEPENDENCY_GRAPH_HPP
@@ -1,17 +1,21 @@
 #ifndef GENODE_FILESYSTEM_HPP
 #define GENODE_FILESYSTEM_HPP
 
+#include <functional>
 #include <memory>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
 #include <typeindex>
-#include <unordered_set>
+#include <vector>
 
 #include <SFML/System/InputStream.hpp>
 
+#include <Genode/IO/BufferPool.hpp>
+#include <Genode/IO/MappedView.hpp>
+
 namespace Gx
 {
-    class LocalFileSystem;
-
     /// Represents an interface that provides FileSystem functionalities.
     class IFileSystem
     {
@@ -29,6 +33,12 @@ namespace Gx
         /// \return Pointer to SFML InputStream if success; otherwise, return nullptr.
         virtual std::unique_ptr<sf::InputStream> Open(const std::string &fileName) = 0;
 
+        /// Map the file content into memory without copying it.
+        /// The default implementation does not support mapping and always return an empty MappedView.
+        /// \param fileName The fileName to map.
+        /// \return MappedView of the file content if success; otherwise, an empty MappedView.
+        virtual MappedView Map(const std::string &fileName) { (void)fileName; return {}; }
+
         /// Read the file and copy its content into a buffer.
         /// \param fileName The fileName to read.
         /// \param data The buffer that will hold the file content.
@@ -42,18 +52,41 @@ namespace Gx
         /// \return The number of bytes that copied from file content into the buffer if success; otherwise, -1.
         virtual std::size_t Read(const std::string &fileName, void *data, std::size_t size) = 0;
 
+        /// Read the whole file content into a buffer acquired from given \p pool.
+        /// The default implementation queries the file size before reading the file, override it to read the file with a single lookup.
+        /// \param fileName The fileName to read.
+        /// \param pool The pool that provides the buffer.
+        /// \return Buffer of the file content if success; otherwise, an invalid Buffer.
+        virtual BufferPool::Buffer ReadAll(const std::string &fileName, BufferPool &pool);
+
         /// Gets the file size of given \p fileName.
         /// \param fileName The fileName to check.
         /// \return File size of file that match with given fileName if success; otherwise, -1.
         virtual std::size_t GetFileSize(const std::string &fileName) = 0;
+
+        /// Resolve the full path of given \p fileName in the disk.
+        /// \param fileName The fileName to get as full path.
+        /// \return Full path of the file if the file is located in the disk; otherwise, an empty string.
+        virtual std::string GetFullName(const std::string &fileName) const { (void)fileName; return {}; }
+
+        /// Hint that the given \p fileName is about to be read, so its content can be brought into the page cache ahead of time.
+        /// The hint must not block on the actual I/O. The default implementation ignores the hint.
+        /// \param fileName The fileName to prefetch.
+        virtual void Prefetch(const std::string &fileName) { (void)fileName; }
     };
 
     /// Represents virtual FileSystem.
+    ///
+    /// \remark
+    /// Mounted FileSystems are queried from the highest to the lowest priority, the most recently mounted FileSystem
+    /// is queried first when priorities are equal. The FileSystem that owns a file name is cached after the first lookup,
+    /// including file names that does not exist in any FileSystem. The cache is invalidated whenever a FileSystem is mounted or dismounted,
+    /// use InvalidateCache when files are added or removed from mounted FileSystems.
     class FileSystem
     {
     public:
         /// Gets mounted FileSystem.
-        /// \return A vector containing pointers to mounted FileSystems.
+        /// \return A vector containing pointers to mounted FileSystems, ordered by their priority.
         static std::vector<IFileSystem*> GetFileSystems();
 
         /// Check whether the given \p fileName is exists within one of mounted FileSystem.
@@ -66,6 +99,11 @@ namespace Gx
         /// \return Pointer to SFML InputStream if success; otherwise, return nullptr.
         static std::unique_ptr<sf::InputStream> Open(const std::string &fileName);
 
+        /// Map the file content into memory without copying it.
+        /// \param fileName The fileName to map.
+        /// \return MappedView of the file content if the owner FileSystem support mapping; otherwise, an empty MappedView.
+        static MappedView Map(const std::string &fileName);
+
         /// Read the file and copy its content into a buffer.
         /// \param fileName The fileName to read.
         /// \param data The buffer that will hold the file content.
@@ -73,26 +111,43 @@ namespace Gx
         /// \return The number of bytes that copied from file content into the buffer if success; otherwise, -1.
         static std::size_t Read(const std::string &fileName, void *data, std::size_t size = 0);
 
+        /// Read the whole file content into a pooled buffer.
+        /// The file is resolved, opened and read once, unlike querying its size with GetFileSize before calling Read.
+        /// \param fileName The fileName to read.
+        /// \param pool The pool that provides the buffer.
+        /// \return Buffer of the file content if success; otherwise, an invalid Buffer.
+        static BufferPool::Buffer ReadAll(const std::string &fileName, BufferPool &pool = BufferPool::GetDefault());
+
         /// Gets the file size of given \p fileName.
         /// \param fileName The fileName to check.
         /// \return File size of file that match with given fileName if success; otherwise, -1.
         static std::size_t GetFileSize(const std::string &fileName);
 
-        /// Resolve the full name of given \p fileName by using one of mounted LocalFileSystem.
+        /// Resolve the full name of given \p fileName by using the mounted FileSystem that owns the file.
         /// \param fileName The fileName to get as full path.
-        /// \return Full path of given fileName that exists within one of mounted LocalFileSystem.
+        /// \return Full path of given fileName if the owner FileSystem located it in the disk; otherwise, an empty string.
         static std::string GetFullName(const std::string &fileName);
 
+        /// Prefetch the given files in the background by using the mounted FileSystem that owns each file.
+        /// The function returns immediately, files that are not found or whose FileSystem does not support prefetching are skipped.
+        /// \param fileNames The fileNames to prefetch.
+        static void Prefetch(const std::vector<std::string> &fileNames);
+
+        /// Discard the cached owner FileSystem of every file name.
+        static void InvalidateCache();
+
         /// Initialize and mount given type of FileSystem.
         /// \tparam FS FileSystem type to mount.
+        /// \param priority Priority of the FileSystem, FileSystem with higher priority is queried first.
         template<class FS>
-        static void Mount();
+        static void Mount(int priority = 0);
 
         /// Mount given instance of FileSystem.
         /// \tparam FS FileSystem type to mount.
         /// \param fs An instance of FileSystem to mount.
+        /// \param priority Priority of the FileSystem, FileSystem with higher priority is queried first.
         template<class FS>
-        static void Mount(std::unique_ptr<FS> fs);
+        static void Mount(std::unique_ptr<FS> fs, int priority = 0);
 
         /// Dismount particular type of FileSystem
         /// \tparam FS FileSystem type to dismount.
@@ -107,11 +162,23 @@ namespace Gx
         static bool Dismount(FS *fs);
 
     private:
-        using FileSystemContainer = std::unordered_set<std::unique_ptr<IFileSystem>>;
+        struct MountPoint
+        {
+            std::unique_ptr<IFileSystem> System;
+            int                          Priority;
+        };
+        using FileSystemContainer = std::vector<MountPoint>;
+        using ResolutionCache     = std::unordered_map<std::string, IFileSystem*>;
 
         static void EnsureDefaultFileSystemRegistered();
+        static void Insert(std::unique_ptr<IFileSystem> fs, int priority);
+        static bool Remove(const std::function<bool(IFileSystem*)> &predicate);
+        static IFileSystem *Resolve(const std::string &fileName);
 
         inline static FileSystemContainer m_systems;
+        inline static ResolutionCache     m_cache;
+        inline static std::shared_mutex   m_mutex;
+        inline static std::shared_mutex   m_cacheMutex;
     };
 }
 
@@ -1,19 +1,21 @@
 namespace Gx
 {
     template<class FS>
-    void FileSystem::Mount()
+    void FileSystem::Mount(int priority)
     {
         static_assert(std::is_base_of<IFileSystem, FS>::value, "Template parameter must inherit Gx::IFileSystem");
-        m_systems.insert(std::make_unique<FS>());
+        EnsureDefaultFileSystemRegistered();
+
+        Insert(std::make_unique<FS>(), priority);
     }
 
     template<class FS>
-    void FileSystem::Mount(std::unique_ptr<FS> fs)
+    void FileSystem::Mount(std::unique_ptr<FS> fs, int priority)
     {
         static_assert(std::is_base_of<IFileSystem, FS>::value, "Template parameter must inherit Gx::IFileSystem");
         EnsureDefaultFileSystemRegistered();
 
-        m_systems.insert(std::move(fs));
+        Insert(std::move(fs), priority);
     }
 
     template<class FS>
@@ -22,14 +24,7 @@ namespace Gx
         static_assert(std::is_base_of<IFileSystem, FS>::value, "Template parameter must inherit Gx::IFileSystem");
         EnsureDefaultFileSystemRegistered();
 
-        std::size_t count = m_systems.size();
-        for (auto it = m_systems.begin(); it != m_systems.end(); it++)
-        {
-            if (typeid(*it->get()) == typeid(FS))
-                m_systems.erase(it--);
-        }
-
-        return m_systems.size() != count;
+        return Remove([] (IFileSystem *fs) { return typeid(*fs) == typeid(FS); });
     }
 
     template<class FS>
@@ -38,15 +33,6 @@ namespace Gx
         static_assert(std::is_base_of<IFileSystem, FS>::value, "Template parameter must inherit Gx::IFileSystem");
         EnsureDefaultFileSystemRegistered();
 
-        for (auto it = m_systems.begin(); it != m_systems.end(); it++)
-        {
-            if (it->get() == fs)
-            {
-                m_systems.erase(it--);
-                return true;
-            }
-        }
-
-        return false;
+        return Remove([fs] (IFileSystem *mounted) { return mounted == fs; });
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,112 @@
+#ifndef GENODE_BATCH_FILE_READER_HPP
+#define GENODE_BATCH_FILE_READER_HPP
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    class ThreadPool;
+
+    /// Reads the whole content of many files in the disk as a single batch.
+    ///
+    /// \remark
+    /// On Linux, the opens and reads of a batch are submitted through io_uring, so the device sees many requests at once
+    /// instead of one blocking read per file, which matters for NVMe drives that need a deep queue to reach their throughput.
+    /// When io_uring is unavailable (older kernels, disabled by the system or other platforms), each file is read with pread on a ThreadPool.
+    ///
+    /// Batches are processed in the background, the completion callback is invoked on the thread that complete the read.
+    class BatchFileReader final : private NonCopyable
+    {
+    public:
+        /// Represents a file to read.
+        struct Request
+        {
+            /// Path of the file in the disk.
+            std::string FileName;
+
+            /// Caller-owned buffer that receive the file content, nullptr to let the reader allocate a buffer.
+            /// The buffer must be alive until the request is completed.
+            void *Buffer = nullptr;
+
+            /// Size of the caller-owned buffer, files that larger than the buffer fail with EFBIG.
+            std::size_t Capacity = 0;
+        };
+
+        /// Represents the outcome of a Request.
+        struct Result
+        {
+            /// Index of the request inside its batch.
+            std::size_t Index = 0;
+
+            /// Path of the file in the disk.
+            std::string FileName;
+
+            /// Buffer allocated by the reader when the request doesn't provide one.
+            std::vector<char> Storage;
+
+            /// Pointer to the file content, either the caller-owned buffer or the Storage.
+            void *Data = nullptr;
+
+            /// Size of the file content, in bytes.
+            std::size_t Size = 0;
+
+            /// Error number of the failed operation, 0 if the file is successfully read.
+            int Error = 0;
+
+            /// Gets a value indicating whether the file is successfully read.
+            bool IsSuccess() const { return Error == 0; }
+        };
+
+        using Callback = std::function<void(Result&)>;
+
+        /// Initializes a new instance of BatchFileReader.
+        /// \param queueDepth The maximum number of requests that submitted to the device at once.
+        /// \param useUring true to use io_uring when it is available; otherwise, false to always use the ThreadPool.
+        explicit BatchFileReader(std::size_t queueDepth = 64, bool useUring = true);
+
+        /// Finishes every submitted batch and releases the resources of BatchFileReader.
+        ~BatchFileReader();
+
+        /// Gets a value indicating whether the batches are read through io_uring.
+        /// \return true if io_uring is used; otherwise, false.
+        bool IsUringEnabled() const;
+
+        /// Read the given files in the background.
+        /// \param requests Files to read.
+        /// \param callback Function to invoke when each file is completed, it may be invoked concurrently by different threads.
+        /// \return Future that become ready once every request in the batch is completed.
+        std::future<void> Read(std::vector<Request> requests, Callback callback);
+
+        /// Read the given files in the background.
+        /// \param requests Files to read.
+        /// \return Future of the results, ordered as the requests.
+        std::future<std::vector<Result>> Read(std::vector<Request> requests);
+
+    private:
+        struct Batch;
+        class Ring;
+
+        static void ReadFile(const Request &request, Result &result);
+
+        void Process(const std::shared_ptr<Batch> &batch);
+        void ProcessPooled(const std::shared_ptr<Batch> &batch);
+        void ReadPooled(const std::shared_ptr<Batch> &batch, std::size_t index);
+
+        std::size_t                 m_queueDepth;
+        std::unique_ptr<Ring>       m_ring;
+        std::atomic<bool>           m_ringFailed = false;
+        std::unique_ptr<ThreadPool> m_submitter;
+        std::unique_ptr<ThreadPool> m_workers;
+        std::once_flag              m_workersCreated;
+    };
+}
+
+#endif //GENODE_BATCH_FILE_READER_HPP
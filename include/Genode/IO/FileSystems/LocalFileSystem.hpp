@@ -4,6 +4,7 @@
 #include <filesystem>
 
 #include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/FileSystems/BatchFileReader.hpp>
 
 namespace Gx
 {
@@ -14,16 +15,70 @@ namespace Gx
         explicit LocalFileSystem(const std::string &root);
         ~LocalFileSystem() override = default;
 
+        /// Set whether the root directory should be scanned once into an in-memory index.
+        ///
+        /// \remark
+        /// When the index is used, existence and size queries of relative file names are served from the index without touching the disk.
+        /// The index is a snapshot, files that added or removed afterward are not visible until Rescan is called.
+        /// \param index true to scan and use the index; otherwise, false to query the disk directly.
+        void UseIndex(bool index);
+
+        /// Set whether files should be memory-mapped instead of read through buffered streams.
+        ///
+        /// \remark
+        /// When mapping is used, Open returns a MappedInputStream and Read copies straight from the mapping.
+        /// Map is always available regardless of this setting. The setting should not be changed while other threads access the FileSystem.
+        /// \param mapping true to map the files; otherwise, false.
+        void UseMemoryMapping(bool mapping);
+
+        /// Scan the root directory and replace the current index.
+        /// Subdirectories of the root are scanned in parallel.
+        void Rescan();
+
+        /// Read the whole content of given files as a single batch in the background.
+        ///
+        /// \remark
+        /// Batches of every LocalFileSystem are submitted through a shared BatchFileReader, which use io_uring when it is available.
+        /// The FileName of each result is the full name of the file in the disk, use the Index to map it back to the given file names.
+        /// \param fileNames The fileNames to read.
+        /// \param callback Function to invoke when each file is completed, it may be invoked concurrently by different threads.
+        /// \return Future that become ready once every file is completed.
+        std::future<void> ReadBatch(const std::vector<std::string> &fileNames, BatchFileReader::Callback callback);
+
+        /// Read the whole content of given files as a single batch in the background.
+        /// \param fileNames The fileNames to read.
+        /// \return Future of the results, ordered as the given file names.
+        std::future<std::vector<BatchFileReader::Result>> ReadBatch(const std::vector<std::string> &fileNames);
+
         bool IsExists(const std::string &fileName) const override;
-        std::string GetFullName(const std::string &fileName) const;
+        std::string GetFullName(const std::string &fileName) const override;
 
         std::unique_ptr<sf::InputStream> Open(const std::string &fileName) override;
+        MappedView Map(const std::string &fileName) override;
         std::size_t Read(const std::string &fileName, void *data) override;
         std::size_t Read(const std::string &fileName, void *data, std::size_t size) override;
+        BufferPool::Buffer ReadAll(const std::string &fileName, BufferPool &pool) override;
         std::size_t GetFileSize(const std::string &fileName) override;
+        void Prefetch(const std::string &fileName) override;
 
     private:
-        std::filesystem::path m_root;
+        struct IndexEntry
+        {
+            std::size_t Size;
+            std::string FullName;
+        };
+        using Index = std::unordered_map<std::string, IndexEntry>;
+
+        static BatchFileReader &GetBatchReader();
+
+        std::vector<BatchFileReader::Request> CreateRequests(const std::vector<std::string> &fileNames) const;
+        std::string GetDiskName(const std::string &fileName) const;
+        std::shared_ptr<const Index> GetIndex() const;
+        const IndexEntry *FindEntry(const Index &index, const std::string &fileName) const;
+
+        std::filesystem::path        m_root;
+        std::shared_ptr<const Index> m_index;
+        bool                         m_mapped;
     };
 
 
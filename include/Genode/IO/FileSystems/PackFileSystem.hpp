@@ -0,0 +1,87 @@
+#ifndef GENODE_PACK_FILESYSTEM_HPP
+#define GENODE_PACK_FILESYSTEM_HPP
+
+#include <map>
+#include <string_view>
+
+#include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/MappedFile.hpp>
+
+namespace Gx
+{
+    /// Represents a read-only FileSystem that serves files from a single packed archive.
+    ///
+    /// \remark
+    /// The archive is memory-mapped, existence and size queries are served from its sorted table of contents
+    /// while streams read the mapped file content directly. Use PackWriter or genode-pack tool to create the archive.
+    class PackFileSystem : public IFileSystem
+    {
+    public:
+        /// Initializes a new instance of PackFileSystem.
+        /// Throws IOException if the archive cannot be mapped or is not a valid archive.
+        /// \param archive Path of the packed archive.
+        explicit PackFileSystem(const std::string &archive);
+        ~PackFileSystem() override = default;
+
+        bool IsExists(const std::string &fileName) const override;
+
+        std::unique_ptr<sf::InputStream> Open(const std::string &fileName) override;
+        MappedView Map(const std::string &fileName) override;
+        std::size_t Read(const std::string &fileName, void *data) override;
+        std::size_t Read(const std::string &fileName, void *data, std::size_t size) override;
+        BufferPool::Buffer ReadAll(const std::string &fileName, BufferPool &pool) override;
+        std::size_t GetFileSize(const std::string &fileName) override;
+        void Prefetch(const std::string &fileName) override;
+
+        /// Gets the number of files inside the archive.
+        /// \return The number of files inside the archive.
+        std::size_t GetEntryCount() const;
+
+    private:
+        struct Entry
+        {
+            std::size_t Offset;
+            std::size_t Size;
+        };
+
+        const unsigned char *FindEntry(const std::string &fileName) const;
+        Entry GetEntry(const unsigned char *record) const;
+        std::string_view GetEntryName(const unsigned char *record) const;
+
+        std::shared_ptr<MappedFile> m_archive;
+        const unsigned char        *m_table;
+        const unsigned char        *m_names;
+        std::size_t                 m_count;
+    };
+
+    /// Provides functionalities to create a packed archive that can be mounted with PackFileSystem.
+    class PackWriter
+    {
+    public:
+        /// Initializes a new instance of PackWriter.
+        PackWriter() = default;
+
+        /// Add every regular file under given \p directory, named by its path relative to the directory.
+        /// \param directory Path of the directory to add.
+        void AddDirectory(const std::string &directory);
+
+        /// Add a file into the archive, a file with the same name will be replaced.
+        /// \param name Name of the file inside the archive.
+        /// \param fileName Path of the file to add.
+        void AddFile(const std::string &name, const std::string &fileName);
+
+        /// Write the archive into the given \p archive path.
+        /// Throws IOException if one of the files or the archive cannot be accessed.
+        /// \param archive Path of the archive to write.
+        void Save(const std::string &archive) const;
+
+        /// Gets the number of files that added into this instance of PackWriter.
+        /// \return The number of files to write.
+        std::size_t GetEntryCount() const;
+
+    private:
+        std::map<std::string, std::string> m_files;
+    };
+}
+
+#endif //GENODE_PACK_FILESYSTEM_HPP
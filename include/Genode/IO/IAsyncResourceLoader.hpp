@@ -0,0 +1,110 @@
+#ifndef GENODE_ASYNC_RESOURCE_LOADER_HPP
+#define GENODE_ASYNC_RESOURCE_LOADER_HPP
+
+#include <Genode/IO/LoadTask.hpp>
+
+#ifdef GENODE_IO_HAS_COROUTINES
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <Genode/IO/IResourceLoader.hpp>
+#include <Genode/IO/ResourceContext.hpp>
+
+namespace Gx
+{
+    /// Represents an interface that describe deserialization process for a particular resource type as a coroutine.
+    ///
+    /// \remark
+    /// LoadFromFileAsync can await its dependencies with ResourceContext::AcquireAsync. When the loader is invoked by
+    /// ResourceManager::AddFromFileAsync, the coroutine is suspended while the dependencies are loaded and then resumed
+    /// on one of the worker threads, so the workers are not blocked by a chain of dependencies.
+    ///
+    /// LoadFromFile runs the coroutine on the calling thread and blocks until it is completed, so the loader can also be used
+    /// through the synchronous functions of ResourceManager and ResourceContext::Acquire.
+    /// \tparam R Represents type of resource that the loader is capable to load.
+    template<class R>
+    class IAsyncResourceLoader : public IResourceLoader<R>
+    {
+    public:
+        /// Load resource from a file as a coroutine.
+        /// The given \p fileName and \p ctx remain valid until the coroutine is completed.
+        /// \param fileName Path of the resource file to load.
+        /// \param ctx Context of the resource loading execution.
+        /// \return LoadTask that produces the loaded resource.
+        virtual LoadTask<std::unique_ptr<R>> LoadFromFileAsync(const std::string &fileName, const ResourceContext &ctx) = 0;
+
+        /// Load resource from a file by running LoadFromFileAsync until it is completed.
+        /// \param fileName Path of the resource file to load.
+        /// \param ctx Context of the resource loading execution.
+        /// \return Pointer to the loaded resource.
+        std::unique_ptr<R> LoadFromFile(const std::string &fileName, const ResourceContext &ctx) final;
+
+    private:
+        // Resumes the coroutine on the blocked thread, so it keeps the load frames and staged uploads of the thread
+        struct BlockingScheduler final : public LoadScheduler
+        {
+            void Suspend() override {}
+            void Resume(std::coroutine_handle<> handle) override;
+
+            std::mutex                          Mutex;
+            std::condition_variable             Ready;
+            std::deque<std::coroutine_handle<>> Pending;
+            bool                                Done = false;
+        };
+    };
+
+    template<class R>
+    std::unique_ptr<R> IAsyncResourceLoader<R>::LoadFromFile(const std::string &fileName, const ResourceContext &ctx)
+    {
+        // Without ResourceManager there's nothing to await, the context may also be shared (e.g. ResourceContext::Default)
+        BlockingScheduler scheduler;
+        auto previous = ctx.m_scheduler;
+        if (ctx.m_resources)
+            ctx.m_scheduler = &scheduler;
+
+        auto task = LoadFromFileAsync(fileName, ctx);
+        task.GetHandle().promise().Completed = [&scheduler] () {
+            std::lock_guard<std::mutex> lock(scheduler.Mutex);
+            scheduler.Done = true;
+        };
+
+        task.GetHandle().resume();
+        while (true)
+        {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(scheduler.Mutex);
+                scheduler.Ready.wait(lock, [&scheduler] { return scheduler.Done || !scheduler.Pending.empty(); });
+                if (scheduler.Pending.empty())
+                    break;
+
+                handle = scheduler.Pending.front();
+                scheduler.Pending.pop_front();
+            }
+
+            handle.resume();
+        }
+
+        if (ctx.m_resources)
+            ctx.m_scheduler = previous;
+
+        return task.Get();
+    }
+
+    template<class R>
+    void IAsyncResourceLoader<R>::BlockingScheduler::Resume(std::coroutine_handle<> handle)
+    {
+        // Notified under the lock, the blocked thread may destroy the scheduler as soon as the coroutine is completed
+        std::lock_guard<std::mutex> lock(Mutex);
+        Pending.push_back(handle);
+        Ready.notify_one();
+    }
+}
+
+#endif //GENODE_IO_HAS_COROUTINES
+#endif //GENODE_ASYNC_RESOURCE_LOADER_HPP
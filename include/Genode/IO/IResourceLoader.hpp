@@ -3,6 +3,8 @@
 
 #include <memory>
 
+#include <SFML/System/InputStream.hpp>
+
 namespace Gx
 {
     class ResourceContext;
@@ -0,0 +1,161 @@
+#ifndef GENODE_INSTRUMENTATION_HPP
+#define GENODE_INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+namespace Gx
+{
+    enum class FileOperation
+    {
+        Open,
+        Read
+    };
+
+    /// Represents an interface that receive the instrumentation events of resource loading.
+    ///
+    /// \remark
+    /// Events are raised from any thread that load resources, including the worker threads of asynchronous loading.
+    /// Therefore, the implementation must be thread-safe.
+    class IInstrumentationSink
+    {
+    public:
+        using Duration = std::chrono::nanoseconds;
+
+        virtual ~IInstrumentationSink() = default;
+
+        /// Called when a resource is deserialized.
+        /// The duration includes the time to load the dependencies of the resource.
+        /// \param type Type of the loaded resource.
+        /// \param id ID of the loaded resource.
+        /// \param duration Time spent to deserialize the resource.
+        virtual void OnResourceLoaded(const std::type_info &type, std::string_view id, Duration duration) = 0;
+
+        /// Called when a resource is looked up before it get deserialized.
+        /// \param type Type of the resource.
+        /// \param id ID of the resource.
+        /// \param hit true if the existing resource is reused and the deserialization is skipped; otherwise, false.
+        virtual void OnCacheLookup(const std::type_info &type, std::string_view id, bool hit) = 0;
+
+        /// Called when a file is accessed through FileSystem.
+        /// \param operation Type of the file access.
+        /// \param fileName Name of the accessed file.
+        /// \param bytes The number of bytes read, 0 for FileOperation::Open.
+        /// \param duration Time spent to access the file.
+        virtual void OnFileAccess(FileOperation operation, const std::string &fileName, std::size_t bytes, Duration duration) = 0;
+    };
+
+    /// Represents a histogram of latency with power of two buckets in microseconds.
+    class LatencyHistogram
+    {
+    public:
+        static constexpr std::size_t BucketCount = 32;
+
+        /// Add given \p duration into the histogram.
+        /// \param duration Duration to add.
+        void Add(IInstrumentationSink::Duration duration);
+
+        /// Gets the number of samples.
+        /// \return The number of samples.
+        std::uint64_t GetCount() const { return m_count; }
+
+        /// Gets the total duration of samples.
+        /// \return The total duration of samples.
+        IInstrumentationSink::Duration GetTotal() const { return m_total; }
+
+        /// Gets the longest duration of samples.
+        /// \return The longest duration of samples.
+        IInstrumentationSink::Duration GetMax() const { return m_max; }
+
+        /// Gets the number of samples in given bucket, bucket \p index counts the samples that below 2^index microseconds.
+        /// \param index Index of the bucket.
+        /// \return The number of samples in the bucket.
+        std::uint64_t GetBucket(std::size_t index) const { return m_buckets[index]; }
+
+        /// Estimate the duration at given percentile by the upper bound of the bucket that contains the percentile.
+        /// \param percentile Percentile to estimate, between 0 and 1.
+        /// \return Estimated duration at given percentile.
+        IInstrumentationSink::Duration GetPercentile(double percentile) const;
+
+    private:
+        std::array<std::uint64_t, BucketCount> m_buckets = {};
+        std::uint64_t                          m_count   = 0;
+        IInstrumentationSink::Duration         m_total   = {};
+        IInstrumentationSink::Duration         m_max     = {};
+    };
+
+    /// Provides central point to dispatch instrumentation events to the installed IInstrumentationSink.
+    ///
+    /// \remark
+    /// Instrumentation is compiled out unless GENODE_IO_INSTRUMENTATION is defined.
+    /// When it is compiled in, events are only measured and dispatched while a sink is installed.
+    class Instrumentation
+    {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        /// Install the sink that receive instrumentation events.
+        /// \param sink Sink to install, nullptr to disable instrumentation.
+        static void SetSink(std::shared_ptr<IInstrumentationSink> sink);
+
+        /// Gets the installed sink.
+        /// \return The installed sink if any; otherwise, nullptr.
+        static std::shared_ptr<IInstrumentationSink> GetSink();
+
+        /// Gets a value indicating whether instrumentation events are dispatched.
+        /// \return true if instrumentation is compiled in and a sink is installed; otherwise, false.
+        static bool IsEnabled()
+        {
+#ifdef GENODE_IO_INSTRUMENTATION
+            return m_enabled.load(std::memory_order_relaxed);
+#else
+            return false;
+#endif
+        }
+
+        /// Gets the start time of a measurement.
+        /// \return Current time if instrumentation is enabled; otherwise, a default TimePoint which skip the measurement.
+        static TimePoint Start()
+        {
+            return IsEnabled() ? Clock::now() : TimePoint();
+        }
+
+        /// Dispatch the load event of a resource whose measurement started at given \p start.
+        static void RecordLoad(const std::type_info &type, std::string_view id, TimePoint start)
+        {
+            if (start != TimePoint())
+                DispatchLoad(type, id, Clock::now() - start);
+        }
+
+        /// Dispatch the lookup event of a resource.
+        static void RecordLookup(const std::type_info &type, std::string_view id, bool hit)
+        {
+            if (IsEnabled())
+                DispatchLookup(type, id, hit);
+        }
+
+        /// Dispatch the file access event whose measurement started at given \p start.
+        static void RecordFileAccess(FileOperation operation, const std::string &fileName, std::size_t bytes, TimePoint start)
+        {
+            if (start != TimePoint())
+                DispatchFileAccess(operation, fileName, bytes, Clock::now() - start);
+        }
+
+    private:
+        static void DispatchLoad(const std::type_info &type, std::string_view id, IInstrumentationSink::Duration duration);
+        static void DispatchLookup(const std::type_info &type, std::string_view id, bool hit);
+        static void DispatchFileAccess(FileOperation operation, const std::string &fileName, std::size_t bytes, IInstrumentationSink::Duration duration);
+
+        inline static std::shared_ptr<IInstrumentationSink> m_sink;
+        inline static std::atomic<bool>                     m_enabled = false;
+    };
+}
+
+#endif //GENODE_INSTRUMENTATION_HPP
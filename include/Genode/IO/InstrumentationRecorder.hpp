@@ -0,0 +1,63 @@
+#ifndef GENODE_INSTRUMENTATION_RECORDER_HPP
+#define GENODE_INSTRUMENTATION_RECORDER_HPP
+
+#include <map>
+#include <mutex>
+
+#include <Genode/IO/Instrumentation.hpp>
+
+namespace Gx
+{
+    /// Represents the aggregated instrumentation of a particular type of resources.
+    struct ResourceLoadStats
+    {
+        /// Latency of resource deserialization.
+        LatencyHistogram Latency;
+
+        /// The number of lookups that reuse the existing resource.
+        std::uint64_t    Hits   = 0;
+
+        /// The number of lookups that invoke the deserialization.
+        std::uint64_t    Misses = 0;
+    };
+
+    /// Represents the aggregated instrumentation of FileSystem access.
+    struct FileAccessStats
+    {
+        /// Latency of FileSystem::Open.
+        LatencyHistogram OpenLatency;
+
+        /// Latency of FileSystem::Read.
+        LatencyHistogram ReadLatency;
+
+        /// The number of bytes read by FileSystem::Read.
+        std::uint64_t    BytesRead = 0;
+    };
+
+    /// Represents an IInstrumentationSink that aggregate the instrumentation events into histograms and counters.
+    class InstrumentationRecorder : public IInstrumentationSink
+    {
+    public:
+        void OnResourceLoaded(const std::type_info &type, std::string_view id, Duration duration) override;
+        void OnCacheLookup(const std::type_info &type, std::string_view id, bool hit) override;
+        void OnFileAccess(FileOperation operation, const std::string &fileName, std::size_t bytes, Duration duration) override;
+
+        /// Gets a snapshot of the aggregated instrumentation of each type of resources.
+        /// \return Aggregated instrumentation keyed by implementation defined name of the resource type.
+        std::map<std::string, ResourceLoadStats> GetResourceStats() const;
+
+        /// Gets a snapshot of the aggregated instrumentation of FileSystem access.
+        /// \return Aggregated instrumentation of FileSystem access.
+        FileAccessStats GetFileStats() const;
+
+        /// Discard the aggregated instrumentation.
+        void Reset();
+
+    private:
+        mutable std::mutex                       m_mutex;
+        std::map<std::string, ResourceLoadStats> m_resources;
+        FileAccessStats                          m_files;
+    };
+}
+
+#endif //GENODE_INSTRUMENTATION_RECORDER_HPP
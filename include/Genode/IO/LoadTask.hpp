@@ -0,0 +1,161 @@
+#ifndef GENODE_LOAD_TASK_HPP
+#define GENODE_LOAD_TASK_HPP
+
+// Coroutine loaders require the library to be built with GENODE_IO_COROUTINES and a C++20 compiler
+#if defined(GENODE_IO_COROUTINES) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    #define GENODE_IO_HAS_COROUTINES
+#endif
+
+#ifdef GENODE_IO_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Gx
+{
+    /// Represents a scheduler that resume the coroutines of a load once the resources they await are loaded.
+    ///
+    /// \remark
+    /// ResourceManager runs each coroutine load with its own scheduler, which resume the coroutine on one of its worker threads.
+    /// Loaders don't interact with the scheduler directly, it is used by ResourceContext::AcquireAsync.
+    class LoadScheduler
+    {
+    public:
+        /// Releases the resources used by LoadScheduler.
+        virtual ~LoadScheduler() = default;
+
+        /// Invoked on the thread that running the coroutine right before it is suspended.
+        virtual void Suspend() = 0;
+
+        /// Schedule the given suspended coroutine to be resumed, this may be invoked from any thread.
+        /// \param handle Handle of the coroutine to resume.
+        virtual void Resume(std::coroutine_handle<> handle) = 0;
+    };
+
+    /// Represents a lazily started coroutine that produce a value, such as the resource of IAsyncResourceLoader.
+    ///
+    /// \remark
+    /// The coroutine starts when the task is awaited by another coroutine, which is resumed once the task is completed.
+    /// Exception that thrown by the coroutine is rethrown to the awaiting coroutine.
+    /// Only LoadTask and ResourceContext::AcquireAsync can be awaited by the coroutines of a load.
+    /// \tparam T Type of value that produced by the coroutine, can be a reference.
+    template<class T>
+    class LoadTask
+    {
+        static_assert(!std::is_void_v<T>, "LoadTask must produce a value.");
+        using Value = std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>;
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_resume() const noexcept {}
+
+            template<class Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            {
+                auto &promise = handle.promise();
+                if (promise.Continuation)
+                    return promise.Continuation;
+
+                // The callback may destroy the coroutine, nothing inside the frame can be accessed afterward
+                if (auto completed = std::move(promise.Completed))
+                    completed();
+
+                return std::noop_coroutine();
+            }
+        };
+
+    public:
+        /// Represents the promise of the coroutine, as required by the language.
+        struct promise_type
+        {
+            LoadTask get_return_object() noexcept { return LoadTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { Error = std::current_exception(); }
+
+            template<class V>
+            void return_value(V &&value)
+            {
+                if constexpr (std::is_reference_v<T>)
+                    Result = std::addressof(value);
+                else
+                    Result.emplace(std::forward<V>(value));
+            }
+
+            std::optional<Value>    Result;
+            std::exception_ptr      Error;
+            std::coroutine_handle<> Continuation;
+            std::function<void()>   Completed;
+        };
+
+        /// Initializes an empty instance of LoadTask.
+        LoadTask() noexcept = default;
+
+        /// Initializes a new instance of LoadTask by moving the coroutine of another task.
+        LoadTask(LoadTask &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+        /// Destroys the coroutine of this instance of LoadTask.
+        ~LoadTask() { if (m_handle) m_handle.destroy(); }
+
+        /// Replace the coroutine of this instance of LoadTask with the coroutine of another task.
+        LoadTask &operator=(LoadTask &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                    m_handle.destroy();
+
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+
+            return *this;
+        }
+
+        /// Gets a value indicating whether the coroutine is completed.
+        /// \return true if the coroutine is completed; otherwise, false.
+        bool IsDone() const { return !m_handle || m_handle.done(); }
+
+        /// Gets the value that produced by the completed coroutine.
+        /// If the coroutine failed, the exception that thrown by the coroutine will be rethrown.
+        /// \return The value that produced by the coroutine.
+        T Get()
+        {
+            auto &promise = m_handle.promise();
+            if (promise.Error)
+                std::rethrow_exception(promise.Error);
+
+            if constexpr (std::is_reference_v<T>)
+                return **promise.Result;
+            else
+                return std::move(*promise.Result);
+        }
+
+        /// Gets the handle of the coroutine.
+        /// \return Handle of the coroutine.
+        std::coroutine_handle<promise_type> GetHandle() const { return m_handle; }
+
+        bool await_ready() const noexcept { return IsDone(); }
+        T await_resume() { return Get(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            // Start the coroutine on the same thread, the awaiting coroutine is resumed by the final awaiter
+            m_handle.promise().Continuation = awaiting;
+            return m_handle;
+        }
+
+    private:
+        explicit LoadTask(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+}
+
+#endif //GENODE_IO_HAS_COROUTINES
+#endif //GENODE_LOAD_TASK_HPP
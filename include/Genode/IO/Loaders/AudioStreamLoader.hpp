@@ -0,0 +1,23 @@
+#ifndef GENODE_AUDIO_STREAM_LOADER_HPP
+#define GENODE_AUDIO_STREAM_LOADER_HPP
+
+#include <Genode/IO/AudioStream.hpp>
+#include <Genode/IO/IResourceLoader.hpp>
+
+namespace Gx
+{
+    class AudioStreamLoader : public IResourceLoader<AudioStream>
+    {
+    public:
+        AudioStreamLoader() = default;
+
+        std::unique_ptr<AudioStream> LoadFromFile(const std::string &fileName, const ResourceContext &ctx) override;
+        std::unique_ptr<AudioStream> LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx) override;
+
+        /// Load the audio from given stream.
+        /// The stream is not owned by the loader, its compressed content is copied into the resulting AudioStream.
+        std::unique_ptr<AudioStream> LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx) override;
+    };
+}
+
+#endif //GENODE_AUDIO_STREAM_LOADER_HPP
@@ -6,8 +6,16 @@
 
 namespace Gx
 {
+    /// Loads sf::SoundBuffer from audio files, the whole audio is decoded into memory.
+    ///
+    /// \remark
+    /// When DecodeCache is enabled, the decoded samples are served from the cache for sources that decoded before.
+    /// Use AudioStream for long audio such as music.
     class SoundBufferLoader : public IResourceLoader<sf::SoundBuffer>
     {
+    private:
+        std::unique_ptr<sf::SoundBuffer> LoadCached(const void *data, std::size_t size);
+
     public:
         SoundBufferLoader() = default;
 
@@ -0,0 +1,56 @@
+#ifndef GENODE_TEXTURE_ATLAS_LOADER_HPP
+#define GENODE_TEXTURE_ATLAS_LOADER_HPP
+
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <Genode/IO/IResourceLoader.hpp>
+#include <Genode/IO/TextureAtlas.hpp>
+
+namespace Gx
+{
+    /// Loads TextureAtlas by packing the images that listed in a manifest.
+    ///
+    /// \remark
+    /// The manifest lists one image per line, either as "name = path" or only the path which is also used as the name.
+    /// Empty lines and lines that start with '#' are ignored. Images are opened through FileSystem.
+    ///
+    /// Images are decoded and packed on the loading thread, only the resulting pages need to be uploaded into the graphics device.
+    /// When the ResourceContext defers uploads, the pages are uploaded by ResourceManager::PumpUploads.
+    class TextureAtlasLoader : public IResourceLoader<TextureAtlas>
+    {
+    public:
+        using Image = std::pair<std::string, sf::Image>;
+
+        TextureAtlasLoader() = default;
+        void UseSmooth(bool smooth);
+
+        /// Set the maximum size of the atlas textures, it must not exceed the maximum texture size of the graphics device.
+        /// \param size Maximum width and height of the atlas textures, in pixels.
+        void SetPageSize(unsigned size);
+
+        /// Set the number of transparent pixels between the packed images, which prevent the neighbouring images from bleeding.
+        /// \param padding Padding between the packed images, in pixels.
+        void SetPadding(unsigned padding);
+
+        std::unique_ptr<TextureAtlas> LoadFromFile(const std::string &fileName, const ResourceContext &ctx) override;
+        std::unique_ptr<TextureAtlas> LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx) override;
+        std::unique_ptr<TextureAtlas> LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx) override;
+
+        /// Pack given decoded images into a TextureAtlas.
+        /// \param images Named images to pack.
+        /// \param ctx Context of the resource loading execution.
+        /// \return Pointer to the TextureAtlas.
+        std::unique_ptr<TextureAtlas> Build(std::vector<Image> images, const ResourceContext &ctx) const;
+
+    private:
+        std::unique_ptr<TextureAtlas> LoadFromManifest(const std::string &manifest, const ResourceContext &ctx) const;
+
+        bool     m_smooth   = true;
+        unsigned m_pageSize = 2048;
+        unsigned m_padding  = 1;
+    };
+}
+
+#endif //GENODE_TEXTURE_ATLAS_LOADER_HPP
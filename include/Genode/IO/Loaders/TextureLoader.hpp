@@ -1,16 +1,26 @@
 #ifndef GENODE_TEXTURE_LOADER_HPP
 #define GENODE_TEXTURE_LOADER_HPP
 
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <Genode/IO/IResourceLoader.hpp>
 
 namespace Gx
 {
+    /// Loads sf::Texture from image files.
+    ///
+    /// \remark
+    /// When the ResourceContext defers uploads, the image is only decoded and the returned texture stays empty
+    /// until ResourceManager::PumpUploads uploads it, which allow the texture to be loaded on worker threads.
+    /// When DecodeCache is enabled, the decoded pixels are served from the cache for sources that decoded before.
     class TextureLoader : public IResourceLoader<sf::Texture>
     {
     private:
         bool m_smooth = true;
 
+        std::unique_ptr<sf::Texture> LoadCached(const void *data, std::size_t size, const ResourceContext &ctx) const;
+        std::unique_ptr<sf::Texture> Stage(std::unique_ptr<sf::Image> image, const ResourceContext &ctx) const;
+
     public:
         TextureLoader() = default;
         void UseSmooth(bool smooth);
@@ -0,0 +1,53 @@
+#ifndef GENODE_MAPPED_FILE_HPP
+#define GENODE_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Represents a read-only memory mapping of a whole file.
+    class MappedFile final : private NonCopyable
+    {
+    public:
+        /// Initializes a new instance of MappedFile that is not associated with any file.
+        MappedFile();
+
+        /// Unmap the file if it is mapped.
+        ~MappedFile();
+
+        /// Map the given file into memory.
+        /// \param fileName Path of the file to map.
+        /// \return true if the file is successfully mapped; otherwise, false.
+        bool Open(const std::string &fileName);
+
+        /// Unmap the file if it is mapped.
+        void Close();
+
+        /// Hint that given range of the mapped file is about to be accessed, so it can be paged in ahead of time.
+        /// \param offset Offset of the range, in bytes.
+        /// \param size Size of the range, in bytes.
+        void Prefetch(std::size_t offset, std::size_t size) const;
+
+        /// Gets a value indicating whether a file is mapped by this instance of MappedFile.
+        /// \return true if a file is mapped; otherwise, false.
+        bool IsOpen() const;
+
+        /// Gets pointer to the mapped file content.
+        /// \return Pointer to the first byte of the mapped file, nullptr if the file is empty or not mapped.
+        const unsigned char *GetData() const;
+
+        /// Gets the size of the mapped file.
+        /// \return Size of the mapped file, in bytes.
+        std::size_t GetSize() const;
+
+    private:
+        const unsigned char *m_data;
+        std::size_t          m_size;
+        bool                 m_open;
+    };
+}
+
+#endif //GENODE_MAPPED_FILE_HPP
@@ -0,0 +1,44 @@
+#ifndef GENODE_MAPPED_INPUT_STREAM_HPP
+#define GENODE_MAPPED_INPUT_STREAM_HPP
+
+#include <memory>
+
+#include <SFML/System/InputStream.hpp>
+
+#include <Genode/IO/MappedFile.hpp>
+
+namespace Gx
+{
+    /// Represents a SFML InputStream that reads a bounded range of a MappedFile without copying it into an intermediate buffer.
+    /// The mapping is kept alive for as long as the stream is alive.
+    class MappedInputStream : public sf::InputStream
+    {
+    public:
+        /// Initializes a new instance of MappedInputStream over the whole mapped file.
+        /// \param file The mapped file to read.
+        explicit MappedInputStream(std::shared_ptr<const MappedFile> file);
+
+        /// Initializes a new instance of MappedInputStream over a range of the mapped file.
+        /// \param file The mapped file to read.
+        /// \param offset Offset of the first byte of the range, in bytes.
+        /// \param size Size of the range, in bytes.
+        MappedInputStream(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t size);
+
+        sf::Int64 read(void *data, sf::Int64 size) override;
+        sf::Int64 seek(sf::Int64 position) override;
+        sf::Int64 tell() override;
+        sf::Int64 getSize() override;
+
+        /// Gets pointer to the first byte of the range that this stream reads.
+        /// \return Pointer to the range within the mapped file.
+        const unsigned char *GetData() const;
+
+    private:
+        std::shared_ptr<const MappedFile> m_file;
+        const unsigned char              *m_data;
+        std::size_t                       m_size;
+        std::size_t                       m_position;
+    };
+}
+
+#endif //GENODE_MAPPED_INPUT_STREAM_HPP
@@ -0,0 +1,51 @@
+#ifndef GENODE_MAPPED_VIEW_HPP
+#define GENODE_MAPPED_VIEW_HPP
+
+#include <algorithm>
+#include <memory>
+
+#include <Genode/IO/MappedFile.hpp>
+
+namespace Gx
+{
+    /// Represents a read-only view of a file content inside a MappedFile.
+    /// The mapping is kept alive for as long as the view or one of its copies is alive.
+    class MappedView
+    {
+    public:
+        /// Initializes an empty instance of MappedView.
+        MappedView() = default;
+
+        /// Initializes a new instance of MappedView over a range of the mapped file.
+        /// \param file The mapped file to view.
+        /// \param offset Offset of the first byte of the range, in bytes.
+        /// \param size Size of the range, in bytes.
+        MappedView(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t size) :
+            m_file(std::move(file))
+        {
+            if (m_file && m_file->GetData() && offset < m_file->GetSize())
+            {
+                m_data = m_file->GetData() + offset;
+                m_size = std::min(size, m_file->GetSize() - offset);
+            }
+        }
+
+        /// Gets pointer to the first byte of the view.
+        /// \return Pointer to the file content, nullptr if the view is empty.
+        const unsigned char *GetData() const { return m_data; }
+
+        /// Gets the size of the view.
+        /// \return Size of the file content, in bytes.
+        std::size_t GetSize() const { return m_size; }
+
+        /// Gets a value indicating whether the view is associated with a file, the file may be empty.
+        explicit operator bool() const { return m_file != nullptr; }
+
+    private:
+        std::shared_ptr<const MappedFile> m_file;
+        const unsigned char              *m_data = nullptr;
+        std::size_t                       m_size = 0;
+    };
+}
+
+#endif //GENODE_MAPPED_VIEW_HPP
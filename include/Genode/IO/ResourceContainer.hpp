@@ -1,10 +1,19 @@
 #ifndef GENODE_RESOURCE_CONTAINER_HPP
 #define GENODE_RESOURCE_CONTAINER_HPP
 
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
+#include <typeinfo>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
+#include <Genode/IO/ResourceHandle.hpp>
+#include <Genode/IO/ResourceID.hpp>
+#include <Genode/IO/ResourceSize.hpp>
+#include <Genode/IO/ResourceStats.hpp>
 #include <Genode/System/NonCopyable.hpp>
 
 namespace Gx
@@ -16,7 +25,37 @@ namespace Gx
         Reuse
     };
 
+    enum class EvictionPolicy
+    {
+        None,
+        LRU,
+        Clock
+    };
+
+    /// Represents the eviction counters of a ResourceContainer.
+    struct EvictionStats
+    {
+        /// The number of resources that evicted to fit the memory budget.
+        std::size_t Evictions     = 0;
+
+        /// The number of evicted resources that loaded again.
+        std::size_t Reloads       = 0;
+
+        /// Estimated size of resources that currently held in memory, in bytes.
+        std::size_t ResidentBytes = 0;
+    };
+
+    class ResourceManager;
+
     /// Provides central point to store, access and destroy a particular type of resources.
+    ///
+    /// \remark
+    /// Resources are kept in a dense slot array and indexed by the hash of their ID.
+    /// Lookups by ResourceID never allocate, while lookups by ResourceHandle resolve directly into the slot array.
+    ///
+    /// When an EvictionPolicy is set, resources that stored with a reloader are evicted once the estimated size of resources exceed the memory budget.
+    /// Evicted resources keep their ID, handle and reloader, so they can be loaded again with Reload.
+    /// Resources without reloader and pinned resources are never evicted.
     /// \tparam R Type of resources that stored inside ResourceContainer.
     template<class R>
     class ResourceContainer final : private NonCopyable
@@ -32,15 +71,17 @@ namespace Gx
         /// \param id Value to identify the given resource.
         /// \param resource Resource to store inside container.
         /// \param mode Specifies store mode to use when storing the resource into this instance of ResourceContainer.
+        /// \param reloader Function to load the resource again after it gets evicted, nullptr to never evict the resource.
+        /// \param sourceSize Size of the source that the resource loaded from, in bytes. See ResourceSize.
         /// \return Reference to Resource that successfully stored into this instance of ResourceContainer.
-        R &Store(const std::string &id, std::unique_ptr<R> resource, CacheMode mode = CacheMode::Update);
+        R &Store(const ResourceID &id, std::unique_ptr<R> resource, CacheMode mode = CacheMode::Update, std::function<std::unique_ptr<R>()> reloader = nullptr, std::size_t sourceSize = 0);
 
         /// Store resource to the ResourceContainer by using given resource deserialization function in which the resulting resource could be identified with given \p id.
         /// \param id Value to identify the resource that produced by deserializer.
         /// \param deserializer Resource deserialization function which describe how resource get loaded.
         /// \param mode Specifies store mode to use when storing the resource into this instance of ResourceContainer.
         /// \return Reference to Resource that successfully stored into this instance of ResourceContainer.
-        R &Store(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode = CacheMode::Reuse);
+        R &Store(const ResourceID &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode = CacheMode::Reuse);
 
         /// Destroy resource from this instance of ResourceContainer.
         /// \param resource Resource to destroy from this instance of ResourceContainer.
@@ -50,19 +91,75 @@ namespace Gx
         /// Destroy resource from this instance of ResourceContainer.
         /// \param id ID of Resource to destroy from this instance of ResourceContainer.
         /// \return true if resource is found and removed from this instance of ResourceContainer; otherwise, false.
-        bool Destroy(const std::string &id);
+        bool Destroy(const ResourceID &id);
+
+        /// Destroy resource from this instance of ResourceContainer.
+        /// \param handle Handle of Resource to destroy from this instance of ResourceContainer.
+        /// \return true if resource is found and removed from this instance of ResourceContainer; otherwise, false.
+        bool Destroy(ResourceHandle<R> handle);
 
         /// Find resource that match with given \p id.
         /// \param id ID of Resource to retrieve from this instance of ResourceContainer.
         /// \return pointer of Resource if there's resource that match with the given id; otherwise, nullptr.
-        R *Find(const std::string &id) const;
+        R *Find(const ResourceID &id) const;
+
+        /// Find resource that referenced by given \p handle.
+        /// \param handle Handle of Resource to retrieve from this instance of ResourceContainer.
+        /// \return pointer of Resource if the handle is not stale; otherwise, nullptr.
+        R *Find(ResourceHandle<R> handle) const;
+
+        /// Load evicted resource that match with given \p id by using its reloader.
+        /// \param id ID of Resource to reload.
+        /// \return pointer of Resource if exists; otherwise, nullptr.
+        R *Reload(const ResourceID &id);
+
+        /// Gets a value indicate whether the resource that match with given \p id is evicted and need to be reloaded.
+        /// \param id ID of Resource to check.
+        /// \return true if Resource is evicted; otherwise, false.
+        bool IsEvicted(const ResourceID &id) const;
+
+        /// Prevent the resource that match with given \p id from being evicted until Unpin is called.
+        /// Pins are counted, each call must be paired with Unpin.
+        /// \param id ID of Resource to pin.
+        /// \return true if Resource is found; otherwise, false.
+        bool Pin(const ResourceID &id);
+
+        /// Release the pin of resource that match with given \p id.
+        /// \param id ID of Resource to unpin.
+        /// \return true if Resource is found and pinned; otherwise, false.
+        bool Unpin(const ResourceID &id);
+
+        /// Set the eviction policy and memory budget of this instance of ResourceContainer.
+        /// Resources are evicted immediately if the estimated size of resources exceed the budget.
+        /// \param policy Policy to select the resource to evict, EvictionPolicy::None to disable eviction.
+        /// \param budget Maximum estimated size of resources to held in memory, in bytes.
+        void SetEvictionPolicy(EvictionPolicy policy, std::size_t budget);
+
+        /// Gets the eviction counters of this instance of ResourceContainer.
+        /// \return The eviction counters of this instance of ResourceContainer.
+        EvictionStats GetEvictionStats() const;
+
+        /// Gets the memory usage of resources inside this instance of ResourceContainer.
+        /// \param largestCount The number of largest resources to include.
+        /// \return The memory usage of resources inside this instance of ResourceContainer.
+        ResourceTypeStats GetStats(std::size_t largestCount = 8) const;
+
+        /// Gets the handle of resource that match with given \p id.
+        /// \param id ID of Resource to get the handle of.
+        /// \return Handle of the Resource if exists; otherwise, an invalid handle.
+        ResourceHandle<R> GetHandle(const ResourceID &id) const;
 
         /// Gets a value indicate whether there's a resource with id that match with given \p id inside this instance of ResourceContainer.
         /// \param id ID of Resource to check.
         /// \return true if Resource is found; otherwise, false.
-        bool Contains(const std::string &id) const;
+        bool Contains(const ResourceID &id) const;
 
-        /// Gets the number of resources inside this instance of ResourceContainer.
+        /// Gets a value indicate whether the resource referenced by given \p handle is still stored inside this instance of ResourceContainer.
+        /// \param handle Handle of Resource to check.
+        /// \return true if Resource is found; otherwise, false.
+        bool Contains(ResourceHandle<R> handle) const;
+
+        /// Gets the number of resources inside this instance of ResourceContainer, including evicted resources.
         /// \return The number of resources inside this instance of ResourceContainer
         std::size_t Count() const;
 
@@ -70,9 +167,72 @@ namespace Gx
         void Clear();
 
     private:
-        using ResourceMap = std::unordered_map<std::string, std::unique_ptr<R>>;
-
-        ResourceMap m_resources;
+        friend class ResourceManager;
+
+        // Usage marks are updated by lookups that only hold a shared lock,
+        // slots are only moved while the container is exclusively locked
+        template<class T>
+        struct UsageMark
+        {
+            UsageMark(T value = T()) : Value(value) {}
+            UsageMark(UsageMark &&other) noexcept : Value(other.Value.load(std::memory_order_relaxed)) {}
+            UsageMark &operator=(UsageMark &&other) noexcept { Value.store(other.Value.load(std::memory_order_relaxed), std::memory_order_relaxed); return *this; }
+
+            mutable std::atomic<T> Value;
+        };
+
+        struct Slot
+        {
+            std::unique_ptr<R>                  Resource;
+            std::function<std::unique_ptr<R>()> Reloader;
+            std::string                         ID;
+            std::uint64_t                       Hash       = 0;
+            std::size_t                         Size       = 0;
+            std::size_t                         SourceSize = 0;
+            std::uint32_t                       Generation = 1;
+            std::uint32_t                       Pins       = 0;
+            std::uint32_t                       Scopes     = 0;
+            bool                                Failed     = false;
+            UsageMark<std::uint64_t>            LastUse;
+            UsageMark<bool>                     Referenced;
+        };
+        using SlotIndex = std::unordered_map<std::uint64_t, std::uint32_t>;
+
+        static constexpr std::uint32_t NoSlot = std::numeric_limits<std::uint32_t>::max();
+
+        const Slot *FindSlot(const ResourceID &id) const;
+        const Slot *FindSlot(ResourceHandle<R> handle) const;
+        R *Touch(const Slot *slot) const;
+        R &Insert(const ResourceID &id, std::unique_ptr<R> resource, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize);
+        R &Fill(std::uint32_t index, std::unique_ptr<R> resource, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize);
+        void Erase(std::uint32_t index);
+        bool Remeasure(const ResourceID &id, const R *resource);
+        bool MarkFailed(const ResourceID &id, const R *resource);
+        void Evict(std::uint32_t keep);
+        bool IsEvictable(std::uint32_t index, std::uint32_t keep) const;
+        std::uint32_t SelectVictim(std::uint32_t keep);
+        ResourceHandle<R> Tag(const ResourceID &id, const R *resource = nullptr);
+        bool Untag(ResourceHandle<R> handle);
+        std::string GetID(ResourceHandle<R> handle) const;
+        std::string GetID(const R &resource) const;
+
+        template<class Key>
+        std::function<std::unique_ptr<R>()> GetReloader(const Key &key) const;
+
+        template<class Key>
+        R *Restore(const Key &key, std::unique_ptr<R> resource);
+
+        std::vector<Slot>                  m_slots;
+        std::vector<std::uint32_t>         m_free;
+        SlotIndex                          m_index;
+        EvictionPolicy                     m_policy    = EvictionPolicy::None;
+        std::size_t                        m_budget    = 0;
+        std::size_t                        m_bytes     = 0;
+        std::size_t                        m_peak      = 0;
+        std::size_t                        m_evictions = 0;
+        std::size_t                        m_reloads   = 0;
+        std::uint32_t                      m_hand      = 0;
+        mutable std::atomic<std::uint64_t> m_clock     = 0;
     };
 }
 
@@ -1,55 +1,63 @@
+#include <algorithm>
+
+#include <Genode/IO/Instrumentation.hpp>
 #include <Genode/IO/IOException.hpp>
 #include "ResourceContainer.hpp"
 
 namespace Gx
 {
     template<class R>
-    R &ResourceContainer<R>::Store(const std::string &id, std::unique_ptr<R> resource, CacheMode mode)
+    R &ResourceContainer<R>::Store(const ResourceID &id, std::unique_ptr<R> resource, CacheMode mode, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize)
     {
         if (resource == nullptr)
-            throw ResourceStoreException(id, "[" + id + "] Cannot store nullptr resource.");
+            throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Cannot store nullptr resource.");
+
+        // Evicted resources still occupy their slot, Find would miss them
+        if (mode == CacheMode::Allocate && Contains(id))
+            throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource with same ID is already exists.");
 
-        auto current = Find(id);
-        if (current)
+        if (mode == CacheMode::Reuse)
         {
-            if (mode == CacheMode::Allocate)
-                throw ResourceStoreException(id, "[" + id + "] Resource with same ID is already exists.");
-            else if (mode == CacheMode::Reuse)
+            if (auto current = Find(id))
                 return *current;
         }
 
-        m_resources[id] = std::move(resource);
-        return *m_resources[id].get();
+        return Insert(id, std::move(resource), std::move(reloader), sourceSize);
     }
 
     template<class R>
-    R &ResourceContainer<R>::Store(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode)
+    R &ResourceContainer<R>::Store(const ResourceID &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode)
     {
-        auto current = Find(id);
-        if (current)
+        if (mode == CacheMode::Allocate && Contains(id))
+            throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource with same ID is already exists.");
+
+        if (mode == CacheMode::Reuse)
         {
-            if (mode == CacheMode::Allocate)
-                throw ResourceStoreException(id, "[" + id + "] Resource with same ID is already exists.");
-            else if (mode == CacheMode::Reuse)
+            if (auto current = Find(id))
+            {
+                Instrumentation::RecordLookup(typeid(R), id.GetName(), true);
                 return *current;
+            }
         }
 
+        Instrumentation::RecordLookup(typeid(R), id.GetName(), false);
+        auto start    = Instrumentation::Start();
         auto resource = deserializer();
+        Instrumentation::RecordLoad(typeid(R), id.GetName(), start);
         if (resource == nullptr)
-            throw ResourceStoreException(id, "[" + id + "] Cannot store nullptr resource.");
+            throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Cannot store nullptr resource.");
 
-        m_resources[id] = std::move(resource);
-        return *m_resources[id].get();
+        return Insert(id, std::move(resource), nullptr, 0);
     }
 
     template<class R>
     bool ResourceContainer<R>::Destroy(const R &resource)
     {
-        for (auto it = m_resources.begin(); it != m_resources.end(); it++)
+        for (std::size_t i = 0; i < m_slots.size(); i++)
         {
-            if (it->second.get() == &resource)
+            if (m_slots[i].Resource.get() == &resource)
             {
-                m_resources.erase(it++);
+                Erase(static_cast<std::uint32_t>(i));
                 return true;
             }
         }
@@ -58,36 +66,163 @@ namespace Gx
     }
 
     template<class R>
-    bool ResourceContainer<R>::Destroy(const std::string &id)
+    bool ResourceContainer<R>::Destroy(const ResourceID &id)
+    {
+        auto slot = FindSlot(id);
+        if (!slot)
+            return false;
+
+        Erase(static_cast<std::uint32_t>(slot - m_slots.data()));
+        return true;
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Destroy(ResourceHandle<R> handle)
+    {
+        if (!FindSlot(handle))
+            return false;
+
+        Erase(handle.Index);
+        return true;
+    }
+
+    template<class R>
+    R *ResourceContainer<R>::Find(const ResourceID &id) const
+    {
+        return Touch(FindSlot(id));
+    }
+
+    template<class R>
+    R *ResourceContainer<R>::Find(ResourceHandle<R> handle) const
+    {
+        return Touch(FindSlot(handle));
+    }
+
+    template<class R>
+    R *ResourceContainer<R>::Reload(const ResourceID &id)
     {
-        return m_resources.erase(id) != 0;
+        auto reloader = GetReloader(id);
+        if (!reloader)
+            return Find(id);
+
+        return Restore(id, reloader());
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::IsEvicted(const ResourceID &id) const
+    {
+        auto slot = FindSlot(id);
+        return slot && !slot->Resource;
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Pin(const ResourceID &id)
+    {
+        auto slot = FindSlot(id);
+        if (!slot)
+            return false;
+
+        m_slots[slot - m_slots.data()].Pins++;
+        return true;
     }
 
     template<class R>
-    R *ResourceContainer<R>::Find(const std::string &id) const
+    bool ResourceContainer<R>::Unpin(const ResourceID &id)
     {
-        if (auto it = m_resources.find(id); it != m_resources.end())
-            return it->second.get();
+        auto slot = FindSlot(id);
+        if (!slot || slot->Pins == 0)
+            return false;
+
+        m_slots[slot - m_slots.data()].Pins--;
+        Evict(NoSlot);
 
-        return nullptr;
+        return true;
     }
 
     template<class R>
-    bool ResourceContainer<R>::Contains(const std::string &id) const
+    void ResourceContainer<R>::SetEvictionPolicy(EvictionPolicy policy, std::size_t budget)
     {
-        return m_resources.find(id) != m_resources.end();
+        m_policy = policy;
+        m_budget = budget;
+
+        Evict(NoSlot);
+    }
+
+    template<class R>
+    EvictionStats ResourceContainer<R>::GetEvictionStats() const
+    {
+        EvictionStats stats;
+        stats.Evictions     = m_evictions;
+        stats.Reloads       = m_reloads;
+        stats.ResidentBytes = m_bytes;
+
+        return stats;
+    }
+
+    template<class R>
+    ResourceTypeStats ResourceContainer<R>::GetStats(std::size_t largestCount) const
+    {
+        ResourceTypeStats stats;
+        stats.Type      = typeid(R).name();
+        stats.Count     = m_index.size();
+        stats.Bytes     = m_bytes;
+        stats.PeakBytes = m_peak;
+
+        for (auto &entry : m_index)
+        {
+            auto &slot = m_slots[entry.second];
+            if (!slot.Resource)
+                continue;
+
+            stats.ResidentCount++;
+            stats.Largest.push_back({ slot.ID, slot.Size });
+        }
+
+        auto bySize = [] (const ResourceUsage &a, const ResourceUsage &b) { return a.Bytes > b.Bytes; };
+        if (stats.Largest.size() > largestCount)
+        {
+            std::partial_sort(stats.Largest.begin(), stats.Largest.begin() + largestCount, stats.Largest.end(), bySize);
+            stats.Largest.resize(largestCount);
+        }
+        else
+            std::sort(stats.Largest.begin(), stats.Largest.end(), bySize);
+
+        return stats;
+    }
+
+    template<class R>
+    ResourceHandle<R> ResourceContainer<R>::GetHandle(const ResourceID &id) const
+    {
+        auto slot = FindSlot(id);
+        if (!slot)
+            return {};
+
+        return { static_cast<std::uint32_t>(slot - m_slots.data()), slot->Generation };
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Contains(const ResourceID &id) const
+    {
+        return FindSlot(id) != nullptr;
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Contains(ResourceHandle<R> handle) const
+    {
+        return FindSlot(handle) != nullptr;
     }
 
     template<class R>
     std::size_t ResourceContainer<R>::Count() const
     {
-        return m_resources.size();
+        return m_index.size();
     }
 
     template<class R>
     void ResourceContainer<R>::Clear()
     {
-        m_resources.clear();
+        while (!m_index.empty())
+            Erase(m_index.begin()->second);
     }
 
     template<class R>
@@ -95,4 +230,302 @@ namespace Gx
     {
         Clear();
     }
-}
\ No newline at end of file
+
+    template<class R>
+    const typename ResourceContainer<R>::Slot *ResourceContainer<R>::FindSlot(const ResourceID &id) const
+    {
+        auto it = m_index.find(id.GetHash());
+        if (it == m_index.end())
+            return nullptr;
+
+        // Guard against hash collision between different IDs
+        auto &slot = m_slots[it->second];
+        if (slot.ID != id.GetName())
+            return nullptr;
+
+        return &slot;
+    }
+
+    template<class R>
+    const typename ResourceContainer<R>::Slot *ResourceContainer<R>::FindSlot(ResourceHandle<R> handle) const
+    {
+        if (handle.Index >= m_slots.size())
+            return nullptr;
+
+        // Generation is bumped whenever a slot is released, so a matching generation means the slot is still occupied
+        auto &slot = m_slots[handle.Index];
+        if (slot.Generation != handle.Generation)
+            return nullptr;
+
+        return &slot;
+    }
+
+    template<class R>
+    R *ResourceContainer<R>::Touch(const Slot *slot) const
+    {
+        if (!slot || !slot->Resource)
+            return nullptr;
+
+        // Usage is only tracked when eviction is enabled to keep lookups free of shared writes
+        if (m_policy == EvictionPolicy::LRU)
+            slot->LastUse.Value.store(m_clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        else if (m_policy == EvictionPolicy::Clock && !slot->Referenced.Value.load(std::memory_order_relaxed))
+            slot->Referenced.Value.store(true, std::memory_order_relaxed);
+
+        return slot->Resource.get();
+    }
+
+    template<class R>
+    R &ResourceContainer<R>::Insert(const ResourceID &id, std::unique_ptr<R> resource, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize)
+    {
+        // Existing resource is replaced in place, so its handles remain valid
+        if (auto it = m_index.find(id.GetHash()); it != m_index.end())
+        {
+            auto &slot = m_slots[it->second];
+            if (slot.ID != id.GetName())
+                throw ResourceStoreException(std::string(id.GetName()), "[" + std::string(id.GetName()) + "] Resource ID hash is collided with [" + slot.ID + "].");
+
+            return Fill(it->second, std::move(resource), std::move(reloader), sourceSize);
+        }
+
+        std::uint32_t index;
+        if (!m_free.empty())
+        {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        auto &slot = m_slots[index];
+        slot.ID    = std::string(id.GetName());
+        slot.Hash  = id.GetHash();
+        m_index.emplace(slot.Hash, index);
+
+        return Fill(index, std::move(resource), std::move(reloader), sourceSize);
+    }
+
+    template<class R>
+    R &ResourceContainer<R>::Fill(std::uint32_t index, std::unique_ptr<R> resource, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize)
+    {
+        auto &slot = m_slots[index];
+        if (slot.Resource)
+            m_bytes -= slot.Size;
+        else if (slot.Reloader)
+            m_reloads++;
+
+        slot.Size       = ResourceSize<R>::Get(*resource, sourceSize);
+        slot.SourceSize = sourceSize;
+        slot.Resource   = std::move(resource);
+        slot.Reloader   = std::move(reloader);
+        slot.Failed     = false;
+        slot.LastUse.Value.store(m_clock.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        slot.Referenced.Value.store(true, std::memory_order_relaxed);
+        m_bytes += slot.Size;
+        m_peak   = std::max(m_peak, m_bytes);
+
+        // The stored resource is returned to the caller, so it must survive the eviction
+        Evict(index);
+        return *slot.Resource;
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Remeasure(const ResourceID &id, const R *resource)
+    {
+        // Deferred uploads change the size of the resource after it is stored
+        auto slot = FindSlot(id);
+        if (!slot || slot->Resource.get() != resource)
+            return false;
+
+        auto index   = static_cast<std::uint32_t>(slot - m_slots.data());
+        auto &target = m_slots[index];
+
+        m_bytes    -= target.Size;
+        target.Size = ResourceSize<R>::Get(*target.Resource, target.SourceSize);
+        m_bytes    += target.Size;
+        m_peak      = std::max(m_peak, m_bytes);
+
+        Evict(index);
+        return true;
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::MarkFailed(const ResourceID &id, const R *resource)
+    {
+        // The flag is cleared once the slot is filled with another resource
+        auto slot = FindSlot(id);
+        if (!slot || slot->Resource.get() != resource)
+            return false;
+
+        m_slots[static_cast<std::uint32_t>(slot - m_slots.data())].Failed = true;
+        return true;
+    }
+
+    template<class R>
+    void ResourceContainer<R>::Erase(std::uint32_t index)
+    {
+        auto &slot = m_slots[index];
+        m_index.erase(slot.Hash);
+        if (slot.Resource)
+            m_bytes -= slot.Size;
+
+        // Generation is bumped so handles of the destroyed resource become stale
+        slot.Resource = nullptr;
+        slot.Reloader = nullptr;
+        slot.ID.clear();
+        slot.Size       = 0;
+        slot.SourceSize = 0;
+        slot.Pins       = 0;
+        slot.Scopes     = 0;
+        slot.Generation++;
+        if (slot.Generation == 0)
+            slot.Generation = 1;
+
+        m_free.push_back(index);
+    }
+
+    template<class R>
+    ResourceHandle<R> ResourceContainer<R>::Tag(const ResourceID &id, const R *resource)
+    {
+        // When the resource is given, the slot must still hold it rather than a resource that replaced it
+        auto slot = FindSlot(id);
+        if (!slot || (resource && slot->Resource.get() != resource))
+            return {};
+
+        auto index = static_cast<std::uint32_t>(slot - m_slots.data());
+        m_slots[index].Scopes++;
+
+        return { index, slot->Generation };
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::Untag(ResourceHandle<R> handle)
+    {
+        // The resource may have been destroyed or its slot reused since it was tagged
+        if (!FindSlot(handle) || m_slots[handle.Index].Scopes == 0)
+            return false;
+
+        // Resource that tagged by multiple scopes is only destroyed by the last one
+        if (--m_slots[handle.Index].Scopes > 0)
+            return false;
+
+        Erase(handle.Index);
+        return true;
+    }
+
+    template<class R>
+    std::string ResourceContainer<R>::GetID(ResourceHandle<R> handle) const
+    {
+        auto slot = FindSlot(handle);
+        return slot ? slot->ID : std::string();
+    }
+
+    template<class R>
+    std::string ResourceContainer<R>::GetID(const R &resource) const
+    {
+        for (auto &slot : m_slots)
+        {
+            if (slot.Resource.get() == &resource)
+                return slot.ID;
+        }
+
+        return {};
+    }
+
+    template<class R>
+    void ResourceContainer<R>::Evict(std::uint32_t keep)
+    {
+        if (m_policy == EvictionPolicy::None)
+            return;
+
+        while (m_bytes > m_budget)
+        {
+            auto index = SelectVictim(keep);
+            if (index == NoSlot)
+                break;
+
+            // Slot is kept along with its reloader, so the resource can be loaded again under the same ID and handle
+            auto &slot = m_slots[index];
+            slot.Resource = nullptr;
+            m_bytes -= slot.Size;
+            m_evictions++;
+        }
+    }
+
+    template<class R>
+    bool ResourceContainer<R>::IsEvictable(std::uint32_t index, std::uint32_t keep) const
+    {
+        auto &slot = m_slots[index];
+        return index != keep && slot.Resource && slot.Reloader && slot.Pins == 0;
+    }
+
+    template<class R>
+    std::uint32_t ResourceContainer<R>::SelectVictim(std::uint32_t keep)
+    {
+        auto count = static_cast<std::uint32_t>(m_slots.size());
+        if (m_policy == EvictionPolicy::LRU)
+        {
+            // Approximated LRU: lookups only stamp the slot, the least recently used slot is searched upon eviction
+            auto victim = NoSlot;
+            auto oldest = std::numeric_limits<std::uint64_t>::max();
+            for (std::uint32_t i = 0; i < count; i++)
+            {
+                auto lastUse = m_slots[i].LastUse.Value.load(std::memory_order_relaxed);
+                if (lastUse < oldest && IsEvictable(i, keep))
+                {
+                    victim = i;
+                    oldest = lastUse;
+                }
+            }
+
+            return victim;
+        }
+
+        // Clock: sweep the slots and give referenced slots a second chance
+        for (std::uint32_t step = 0; step < count * 2; step++)
+        {
+            auto index = m_hand;
+            m_hand = (m_hand + 1) % count;
+            if (!IsEvictable(index, keep))
+                continue;
+
+            if (m_slots[index].Referenced.Value.exchange(false, std::memory_order_relaxed))
+                continue;
+
+            return index;
+        }
+
+        return NoSlot;
+    }
+
+    template<class R>
+    template<class Key>
+    std::function<std::unique_ptr<R>()> ResourceContainer<R>::GetReloader(const Key &key) const
+    {
+        auto slot = FindSlot(key);
+        if (!slot || slot->Resource)
+            return nullptr;
+
+        return slot->Reloader;
+    }
+
+    template<class R>
+    template<class Key>
+    R *ResourceContainer<R>::Restore(const Key &key, std::unique_ptr<R> resource)
+    {
+        // The resource may have been reloaded or destroyed since the reloader is acquired
+        auto slot = FindSlot(key);
+        if (!slot)
+            return nullptr;
+        else if (slot->Resource)
+            return Touch(slot);
+        else if (!resource)
+            return nullptr;
+
+        auto index = static_cast<std::uint32_t>(slot - m_slots.data());
+        return &Fill(index, std::move(resource), slot->Reloader, slot->SourceSize);
+    }
+}
@@ -1,11 +1,25 @@
 #ifndef GENODE_RESOURCE_CONTEXT_HPP
 #define GENODE_RESOURCE_CONTEXT_HPP
 
+#include <functional>
+
 #include <SFML/System/FileInputStream.hpp>
 
+#include <Genode/IO/LoadTask.hpp>
+#include <Genode/IO/ResourceFuture.hpp>
+#include <Genode/IO/UploadSink.hpp>
+
 namespace Gx
 {
     class ResourceManager;
+    class LoadScheduler;
+
+    template<class R>
+    class IAsyncResourceLoader;
+
+    template<class R>
+    class AcquireAwaiter;
+
     class ResourceContext
     {
     public:
@@ -26,6 +40,7 @@ namespace Gx
 
         /// Acquire resource dependency that match with given Resource Type and Resource ID.
         /// If resource with given \p id is not stored inside ResourceManager, it will throw ResourceAccessException.
+        /// If the resource is being loaded by another thread, this waits until the load is completed.
         /// \tparam R Type of Resource dependency to acquire.
         /// \param id ID of Resource to look up.
         /// \return pointer of Resource that managed by ResourceManager if exists; otherwise, throw ResourceAccessException.
@@ -60,12 +75,72 @@ namespace Gx
         template<class R>
         R& Acquire(const std::string &id, sf::InputStream &stream) const;
 
+#ifdef GENODE_IO_HAS_COROUTINES
+        /// Acquire resource dependency that match with given Resource Type and Resource ID without blocking the calling coroutine.
+        /// If resource with given \p id is not stored inside ResourceManager, it is loaded from a file of given path on one of the worker threads
+        /// while the calling coroutine is suspended. This can only be awaited by the coroutine of IAsyncResourceLoader.
+        /// \tparam R Type of Resource dependency to acquire.
+        /// \param id ID of Resource to look up.
+        /// \param path Path of Resource file to load when Resource with given \p id is not stored inside ResourceManager.
+        /// \return Awaitable that produces the reference of Resource managed by ResourceManager.
+        template<class R>
+        AcquireAwaiter<R> AcquireAsync(const std::string &id, const std::string &path) const;
+#endif
+
+        /// Gets a value indicating whether the loader should defer the upload of the resource into the graphics device.
+        /// \return true if uploads are deferred to ResourceManager::PumpUploads; otherwise, false.
+        bool IsUploadDeferred() const;
+
+        /// Defer the upload of given \p resource until ResourceManager::PumpUploads is called.
+        /// The upload is discarded if the resource is destroyed or replaced before it get pumped, the resource stays empty if the upload failed, see ResourceManager::IsUploadFailed.
+        /// \tparam R Type of Resource to upload.
+        /// \param resource Resource that is being loaded by this context.
+        /// \param bytes Size of data to upload, in bytes. See ResourceManager::PumpUploads.
+        /// \param upload Function that perform the upload through the IUploadSink, it returns false if the upload failed.
+        template<class R>
+        void DeferUpload(R &resource, std::size_t bytes, std::function<bool(IUploadSink&, R&)> upload) const;
+
     private:
+        friend class ResourceManager;
+
+        template<class R>
+        friend class IAsyncResourceLoader;
+
+        template<class R>
+        friend class AcquireAwaiter;
+
         const std::string m_id;
         mutable ResourceManager *m_resources;
+        mutable LoadScheduler   *m_scheduler;
 
         ResourceContext() noexcept;
     };
+
+#ifdef GENODE_IO_HAS_COROUTINES
+    /// Represents the awaitable that returned by ResourceContext::AcquireAsync.
+    /// \tparam R Type of Resource dependency to acquire.
+    template<class R>
+    class AcquireAwaiter
+    {
+    public:
+        /// Initializes a new instance of AcquireAwaiter.
+        /// \param ctx Context of the resource loading execution that acquire the dependency.
+        /// \param id ID of Resource to look up.
+        /// \param path Path of Resource file to load when Resource with given \p id is not stored inside ResourceManager.
+        AcquireAwaiter(const ResourceContext &ctx, std::string id, std::string path);
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        R &await_resume();
+
+    private:
+        const ResourceContext &m_ctx;
+        std::string            m_id;
+        std::string            m_path;
+        R                     *m_resource;
+        ResourceFuture<R>      m_future;
+    };
+#endif
 }
 
 #include <Genode/IO/ResourceContext.inl>
@@ -8,10 +8,15 @@ namespace Gx
         if (!m_resources)
             throw ResourceAccessException(id, "ResourceManager is not set within this context.");
 
+        // The resource may still be loaded by another thread
         auto resource = m_resources->Find<R>(id);
+        if (!resource)
+            resource = m_resources->Await<R>(id);
+
         if (!resource)
             throw ResourceAccessException(id);
 
+        m_resources->RecordDependency<R>(id);
         return *resource;
     }
 
@@ -21,7 +26,10 @@ namespace Gx
         if (!m_resources)
             throw ResourceAccessException(id, "ResourceManager is not set within this context.");
 
-        return m_resources->AddFromFile<R>(id, path, CacheMode::Reuse);
+        auto &resource = m_resources->AddFromFile<R>(id, path, CacheMode::Reuse);
+        m_resources->RecordDependency<R>(id);
+
+        return resource;
     }
 
     template<class R>
@@ -30,7 +38,10 @@ namespace Gx
         if (!m_resources)
             throw ResourceAccessException(id, "ResourceManager is not set within this context.");
 
-        return m_resources->AddFromMemory<R>(id, data, dataSize, CacheMode::Reuse);
+        auto &resource = m_resources->AddFromMemory<R>(id, data, dataSize, CacheMode::Reuse);
+        m_resources->RecordDependency<R>(id);
+
+        return resource;
     }
 
     template<class R>
@@ -39,6 +50,76 @@ namespace Gx
         if (!m_resources)
             throw ResourceAccessException(id, "ResourceManager is not set within this context.");
 
-        return m_resources->AddFromStream<R>(id, stream, CacheMode::Reuse);
+        auto &resource = m_resources->AddFromStream<R>(id, stream, CacheMode::Reuse);
+        m_resources->RecordDependency<R>(id);
+
+        return resource;
+    }
+
+#ifdef GENODE_IO_HAS_COROUTINES
+    template<class R>
+    AcquireAwaiter<R> ResourceContext::AcquireAsync(const std::string &id, const std::string &path) const
+    {
+        if (!m_resources)
+            throw ResourceAccessException(id, "ResourceManager is not set within this context.");
+
+        return AcquireAwaiter<R>(*this, id, path);
+    }
+
+    template<class R>
+    AcquireAwaiter<R>::AcquireAwaiter(const ResourceContext &ctx, std::string id, std::string path) :
+        m_ctx(ctx),
+        m_id(std::move(id)),
+        m_path(std::move(path)),
+        m_resource(nullptr),
+        m_future()
+    {
+    }
+
+    template<class R>
+    bool AcquireAwaiter<R>::await_ready()
+    {
+        m_resource = m_ctx.m_resources->template Find<R>(m_id);
+        if (m_resource)
+            return true;
+
+        m_future = m_ctx.m_resources->template AddFromFileAsync<R>(m_id, m_path, CacheMode::Reuse);
+        return m_future.IsReady();
+    }
+
+    template<class R>
+    void AcquireAwaiter<R>::await_suspend(std::coroutine_handle<> handle)
+    {
+        // Without scheduler the coroutine is resumed by the thread that completes the dependency
+        auto scheduler = m_ctx.m_scheduler;
+        if (scheduler)
+            scheduler->Suspend();
+
+        m_future.OnCompleted([scheduler, handle] () {
+            if (scheduler)
+                scheduler->Resume(handle);
+            else
+                handle.resume();
+        });
+    }
+
+    template<class R>
+    R &AcquireAwaiter<R>::await_resume()
+    {
+        if (!m_resource)
+            m_resource = &m_future.Get();
+
+        m_ctx.m_resources->template RecordDependency<R>(m_id);
+        return *m_resource;
+    }
+#endif
+
+    template<class R>
+    void ResourceContext::DeferUpload(R &resource, std::size_t bytes, std::function<bool(IUploadSink&, R&)> upload) const
+    {
+        if (!m_resources)
+            throw ResourceAccessException(m_id, "ResourceManager is not set within this context.");
+
+        m_resources->StageUpload<R>(m_id, resource, bytes, std::move(upload));
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,77 @@
+#ifndef GENODE_RESOURCE_FUTURE_HPP
+#define GENODE_RESOURCE_FUTURE_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SFML/System/Time.hpp>
+
+namespace Gx
+{
+    class ResourceManager;
+
+    /// Represents the result of an asynchronous resource load that is committed into a ResourceManager.
+    /// \tparam R Type of the resource that being loaded.
+    template<class R>
+    class ResourceFuture
+    {
+    public:
+        /// Initializes an empty instance of ResourceFuture that is not associated with any load.
+        ResourceFuture() = default;
+
+        /// Gets a value indicating whether this instance of ResourceFuture is associated with a load.
+        /// \return true if the future is associated with a load; otherwise, false.
+        bool IsValid() const;
+
+        /// Gets a value indicating whether the associated load is completed, either successfully or not.
+        /// \return true if the load is completed; otherwise, false.
+        bool IsReady() const;
+
+        /// Block the calling thread until the associated load is completed.
+        void Wait() const;
+
+        /// Block the calling thread until the associated load is completed or the given \p timeout elapsed.
+        /// \param timeout Maximum amount of time to wait.
+        /// \return true if the load is completed; otherwise, false.
+        bool WaitFor(sf::Time timeout) const;
+
+        /// Wait for the associated load and get the resource that committed into the ResourceManager.
+        /// If the load failed, the exception that thrown during the load will be rethrown.
+        /// \return Reference to the resource that managed by ResourceManager.
+        R &Get() const;
+
+        /// Invoke the given \p continuation once the associated load is completed, either successfully or not.
+        /// The continuation is invoked on the thread that completes the load, or immediately if the load is already completed.
+        /// \param continuation Function to invoke, it must not throw.
+        void OnCompleted(std::function<void()> continuation) const;
+
+    private:
+        friend class ResourceManager;
+
+        struct State
+        {
+            std::mutex              Mutex;
+            std::condition_variable Completed;
+            bool                    Done     = false;
+            R                      *Resource = nullptr;
+            std::exception_ptr      Error;
+
+            std::vector<std::function<void()>> Continuations;
+        };
+
+        explicit ResourceFuture(std::shared_ptr<State> state);
+
+        void SetResult(R &resource) const;
+        void SetException(std::exception_ptr error) const;
+        void Complete(std::unique_lock<std::mutex> &lock) const;
+
+        std::shared_ptr<State> m_state;
+    };
+}
+
+#include <Genode/IO/ResourceFuture.inl>
+#endif //GENODE_RESOURCE_FUTURE_HPP
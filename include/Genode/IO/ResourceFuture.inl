@@ -0,0 +1,106 @@
+#include <chrono>
+
+#include <Genode/IO/IOException.hpp>
+
+namespace Gx
+{
+    template<class R>
+    ResourceFuture<R>::ResourceFuture(std::shared_ptr<State> state) :
+        m_state(std::move(state))
+    {
+    }
+
+    template<class R>
+    bool ResourceFuture<R>::IsValid() const
+    {
+        return m_state != nullptr;
+    }
+
+    template<class R>
+    bool ResourceFuture<R>::IsReady() const
+    {
+        if (!m_state)
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_state->Mutex);
+        return m_state->Done;
+    }
+
+    template<class R>
+    void ResourceFuture<R>::Wait() const
+    {
+        if (!m_state)
+            throw ResourceAccessException({}, "ResourceFuture is not associated with any resource load.");
+
+        std::unique_lock<std::mutex> lock(m_state->Mutex);
+        m_state->Completed.wait(lock, [this] { return m_state->Done; });
+    }
+
+    template<class R>
+    bool ResourceFuture<R>::WaitFor(sf::Time timeout) const
+    {
+        if (!m_state)
+            throw ResourceAccessException({}, "ResourceFuture is not associated with any resource load.");
+
+        std::unique_lock<std::mutex> lock(m_state->Mutex);
+        return m_state->Completed.wait_for(lock, std::chrono::microseconds(timeout.asMicroseconds()), [this] { return m_state->Done; });
+    }
+
+    template<class R>
+    R &ResourceFuture<R>::Get() const
+    {
+        Wait();
+        if (m_state->Error)
+            std::rethrow_exception(m_state->Error);
+
+        return *m_state->Resource;
+    }
+
+    template<class R>
+    void ResourceFuture<R>::OnCompleted(std::function<void()> continuation) const
+    {
+        if (!m_state)
+            throw ResourceAccessException({}, "ResourceFuture is not associated with any resource load.");
+
+        {
+            std::lock_guard<std::mutex> lock(m_state->Mutex);
+            if (!m_state->Done)
+            {
+                m_state->Continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+
+        continuation();
+    }
+
+    template<class R>
+    void ResourceFuture<R>::SetResult(R &resource) const
+    {
+        std::unique_lock<std::mutex> lock(m_state->Mutex);
+        m_state->Resource = &resource;
+        Complete(lock);
+    }
+
+    template<class R>
+    void ResourceFuture<R>::SetException(std::exception_ptr error) const
+    {
+        std::unique_lock<std::mutex> lock(m_state->Mutex);
+        m_state->Error = std::move(error);
+        Complete(lock);
+    }
+
+    template<class R>
+    void ResourceFuture<R>::Complete(std::unique_lock<std::mutex> &lock) const
+    {
+        m_state->Done = true;
+        auto continuations = std::move(m_state->Continuations);
+        lock.unlock();
+
+        m_state->Completed.notify_all();
+
+        // Continuations may register further continuations on other futures, they run without holding the lock
+        for (auto &continuation : continuations)
+            continuation();
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef GENODE_RESOURCE_HANDLE_HPP
+#define GENODE_RESOURCE_HANDLE_HPP
+
+#include <cstdint>
+
+namespace Gx
+{
+    /// Represents a compact reference to a resource stored inside a ResourceContainer.
+    ///
+    /// \remark
+    /// A handle resolves in constant time and detects stale use: once the resource is destroyed,
+    /// the handle no longer resolves even if its slot is reused by another resource.
+    /// \tparam R Type of the referenced resource.
+    template<class R>
+    struct ResourceHandle
+    {
+        /// Index of the slot inside the container.
+        std::uint32_t Index      = 0;
+
+        /// Generation of the slot when the handle is acquired, 0 for an invalid handle.
+        std::uint32_t Generation = 0;
+
+        /// Gets a value indicating whether this handle was acquired from a container.
+        /// A valid handle may still be stale, use ResourceContainer::Contains to check it.
+        /// \return true if the handle was acquired from a container; otherwise, false.
+        bool IsValid() const { return Generation != 0; }
+
+        bool operator==(const ResourceHandle &other) const { return Index == other.Index && Generation == other.Generation; }
+        bool operator!=(const ResourceHandle &other) const { return !(*this == other); }
+    };
+}
+
+#endif //GENODE_RESOURCE_HANDLE_HPP
@@ -0,0 +1,68 @@
+#ifndef GENODE_RESOURCE_ID_HPP
+#define GENODE_RESOURCE_ID_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Gx
+{
+    /// Represents a pre-hashed identifier of a resource.
+    ///
+    /// \remark
+    /// ResourceID does not own the name, it is meant to be passed to lookups rather than to be stored.
+    /// Use _rid literal to hash the ID at compile-time, e.g. "ui/button"_rid.
+    class ResourceID
+    {
+    public:
+        /// Initializes a new instance of ResourceID from a null-terminated string.
+        /// \param name Name of the resource.
+        constexpr ResourceID(const char *name) : ResourceID(std::string_view(name)) {};
+
+        /// Initializes a new instance of ResourceID from a string view.
+        /// \param name Name of the resource.
+        constexpr ResourceID(std::string_view name) : m_name(name), m_hash(Hash(name)) {};
+
+        /// Initializes a new instance of ResourceID from a string.
+        /// \param name Name of the resource.
+        ResourceID(const std::string &name) : ResourceID(std::string_view(name)) {};
+
+        /// Gets the name of the resource.
+        /// \return Name of the resource.
+        constexpr std::string_view GetName() const { return m_name; }
+
+        /// Gets the hash of the resource name.
+        /// \return 64-bit FNV-1a hash of the resource name.
+        constexpr std::uint64_t GetHash() const { return m_hash; }
+
+        /// Compute the hash of given resource \p name.
+        /// \param name Name of the resource.
+        /// \return 64-bit FNV-1a hash of the resource name.
+        static constexpr std::uint64_t Hash(std::string_view name)
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            for (auto c : name)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+
+    private:
+        std::string_view m_name;
+        std::uint64_t    m_hash;
+    };
+
+    inline namespace Literals
+    {
+        /// Create a ResourceID that hashed at compile-time.
+        constexpr ResourceID operator""_rid(const char *name, std::size_t size)
+        {
+            return ResourceID(std::string_view(name, size));
+        }
+    }
+}
+
+#endif //GENODE_RESOURCE_ID_HPP
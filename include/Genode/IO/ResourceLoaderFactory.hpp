@@ -1,6 +1,9 @@
 #ifndef GENODE_RESOURCE_LOADER_FACTORY_HPP
 #define GENODE_RESOURCE_LOADER_FACTORY_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <typeindex>
 #include <unordered_map>
 
@@ -12,6 +15,26 @@ namespace Gx
     class ResourceLoaderFactory
     {
     public:
+        /// Releases a loader that acquired via AcquireResourceLoaderFor.
+        /// Cached loaders are returned to the cache instead of being destroyed.
+        struct LoaderDeleter
+        {
+            bool *InUse = nullptr;
+
+            template<class L>
+            void operator()(L *loader) const
+            {
+                if (InUse)
+                    *InUse = false;
+                else
+                    delete loader;
+            }
+        };
+
+        /// Represents a loader that acquired via AcquireResourceLoaderFor.
+        template<class R>
+        using LoaderPtr = std::unique_ptr<IResourceLoader<R>, LoaderDeleter>;
+
         /// Register a new IResourceLoader.
         /// \tparam R Type of Resource that associated to the IResourceLoader.
         /// \tparam L Loader type that used for loading associated resource type.
@@ -34,17 +57,46 @@ namespace Gx
         template<class R>
         static std::unique_ptr<IResourceLoader<R>> CreateResourceLoaderFor();
 
+        /// Acquire the right IResourceLoader implementation for the given type of resource.
+        ///
+        /// \remark
+        /// When cached loaders are used, each thread keeps one instance of the loader per resource type and reuse it across loads,
+        /// so the loader can keep its internal state (e.g. decode buffers) warm. The cached instance is only handed out once at a time,
+        /// nested loads of the same resource type on the same thread receive a new instance instead.
+        /// Otherwise, a new instance is created like CreateResourceLoaderFor.
+        /// \tparam R Type of Resource that wish to be loaded by IResourceLoader.
+        /// \return One of IResourceLoader implementation that capable to load given type of resource.
+        template<class R>
+        static LoaderPtr<R> AcquireResourceLoaderFor();
+
+        /// Set whether the loaders that acquired via AcquireResourceLoaderFor should be cached per thread.
+        /// \param cache true to reuse loader instances; otherwise, false to create a new instance for each acquisition.
+        static void UseCachedLoaders(bool cache);
+
     private:
-        struct ILoaderFactory {};
+        struct ILoaderFactory
+        {
+            virtual ~ILoaderFactory() = default;
+        };
 
         template<class R>
         struct LoaderFactory : public ILoaderFactory
         {
             std::function<std::unique_ptr<IResourceLoader<R>>()> Create;
         };
+
+        template<class R>
+        struct LoaderCache
+        {
+            inline static thread_local std::unique_ptr<IResourceLoader<R>> Instance;
+            inline static thread_local std::uint64_t                        Version = 0;
+            inline static thread_local bool                                 InUse   = false;
+        };
         using LoaderMap = std::unordered_map<std::type_index, std::unique_ptr<ILoaderFactory>>;
 
-        inline static LoaderMap m_loaders;
+        inline static LoaderMap                  m_loaders;
+        inline static std::atomic<std::uint64_t> m_version = 1;
+        inline static std::atomic<bool>          m_cached  = false;
     };
 }
 
@@ -3,22 +3,26 @@
 #include <SFML/Graphics/Font.hpp>
 
 #include <Genode/IO/Loaders/TextureLoader.hpp>
+#include <Genode/IO/Loaders/TextureAtlasLoader.hpp>
 #include <Genode/IO/Loaders/FontLoader.hpp>
 #include <Genode/IO/Loaders/SoundBufferLoader.hpp>
+#include <Genode/IO/Loaders/AudioStreamLoader.hpp>
 
 namespace
 {
     void EnsureDefaultLoadersRegistered()
     {
-        static bool registered = false;
-        if (!registered)
-        {
-            Gx::ResourceLoaderFactory::Register<sf::Texture,     Gx::TextureLoader>();
-            Gx::ResourceLoaderFactory::Register<sf::Font,        Gx::FontLoader>();
-            Gx::ResourceLoaderFactory::Register<sf::SoundBuffer, Gx::SoundBufferLoader>();
+        // Function-local static initialization is thread-safe, loaders may be requested from worker threads
+        static const bool registered = [] {
+            Gx::ResourceLoaderFactory::Register<sf::Texture,      Gx::TextureLoader>();
+            Gx::ResourceLoaderFactory::Register<Gx::TextureAtlas, Gx::TextureAtlasLoader>();
+            Gx::ResourceLoaderFactory::Register<sf::Font,         Gx::FontLoader>();
+            Gx::ResourceLoaderFactory::Register<sf::SoundBuffer,  Gx::SoundBufferLoader>();
+            Gx::ResourceLoaderFactory::Register<Gx::AudioStream,  Gx::AudioStreamLoader>();
 
-            registered = true;
-        }
+            return true;
+        }();
+        (void)registered;
     }
 }
 
@@ -34,6 +38,7 @@ namespace Gx
         factory->Create = [] { return std::make_unique<L>(); };
 
         m_loaders[typeid(R)] = std::move(factory);
+        m_version++;
     }
 
     template<class R>
@@ -45,11 +50,14 @@ namespace Gx
         factory->Create = loader;
 
         m_loaders[typeid(R)] = std::move(factory);
+        m_version++;
     }
 
     template<class R>
     bool ResourceLoaderFactory::Remove()
     {
+        // Cached loaders of every thread are discarded on their next acquisition
+        m_version++;
         return m_loaders.erase(typeid(R)) != 0;
     }
 
@@ -65,4 +73,29 @@ namespace Gx
         auto factory = static_cast<LoaderFactory<R>*>(it->second.get());
         return factory->Create();
     }
-}
\ No newline at end of file
+
+    template<class R>
+    ResourceLoaderFactory::LoaderPtr<R> ResourceLoaderFactory::AcquireResourceLoaderFor()
+    {
+        using Cache = LoaderCache<R>;
+        if (!m_cached.load(std::memory_order_relaxed))
+            return LoaderPtr<R>(CreateResourceLoaderFor<R>().release());
+
+        // The cached instance is busy on this thread (nested load of same type), hand out a new one instead
+        if (Cache::InUse)
+            return LoaderPtr<R>(CreateResourceLoaderFor<R>().release());
+
+        auto version = m_version.load(std::memory_order_acquire);
+        if (!Cache::Instance || Cache::Version != version)
+        {
+            Cache::Instance = CreateResourceLoaderFor<R>();
+            Cache::Version  = version;
+
+            if (!Cache::Instance)
+                return nullptr;
+        }
+
+        Cache::InUse = true;
+        return LoaderPtr<R>(Cache::Instance.get(), LoaderDeleter{&Cache::InUse});
+    }
+}
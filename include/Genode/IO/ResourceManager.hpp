@@ -1,20 +1,57 @@
 #ifndef GENODE_RESOURCE_MANAGER_HPP
 #define GENODE_RESOURCE_MANAGER_HPP
 
-#include <typeindex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Time.hpp>
 
+#include <Genode/IO/DependencyGraph.hpp>
 #include <Genode/IO/ResourceContainer.hpp>
+#include <Genode/IO/ResourceFuture.hpp>
 #include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/IResourceLoader.hpp>
+#include <Genode/IO/LoadTask.hpp>
+#include <Genode/IO/UploadSink.hpp>
+#include <Genode/System/ThreadPool.hpp>
 
 namespace Gx
 {
     class ResourceContext;
+    class ResourceScope;
+
+    template<class R>
+    class AcquireAwaiter;
 
     /// Represents a manager that load, manage and instantiate various type of resources.
+    ///
+    /// \remark
+    /// Resources can be added from worker threads through the asynchronous functions.
+    /// Find, Add, Destroy and Instantiate are safe to call from any thread while asynchronous loads are running.
+    ///
+    /// Loads with CacheMode::Reuse are deduplicated: when the same resource is requested while it is still being loaded,
+    /// the request waits for the ongoing load instead of deserializing the resource again.
+    /// A wait that would close a cycle between the loads of different threads throws ResourceLoadException instead.
+    ///
+    /// When dependency tracking is enabled, the resources that acquired by the loaders through ResourceContext are recorded into a DependencyGraph.
+    /// Destroying a resource also destroys its dependencies that no other stored resource depends on, unless they are added directly.
+    ///
+    /// When the library is built with GENODE_IO_COROUTINES, AddFromFileAsync runs the coroutine of IAsyncResourceLoader,
+    /// which is suspended while its dependencies are loaded and resumed on one of the worker threads once they are completed.
     class ResourceManager final : public NonCopyable
     {
     public:
@@ -32,6 +69,7 @@ namespace Gx
 
         /// Release responsibility from managing the given type of resource for this instance of ResourceManager.
         /// All resources that match with given type inside this ResourceManager will immediately destroyed.
+        /// Loads of the given type that are still in progress fail with ResourceStoreException.
         /// \tparam R Type of Resource to release by this instance of ResourceManager.
         /// \return a value indicating whether given type of resource is indeed managed by ResourceManager and successfully destroyed.
         template<class R>
@@ -136,18 +174,166 @@ namespace Gx
         template<class R>
         R &AddFromDeserializer(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode = CacheMode::Update);
 
+        /// Add resource to this instance of ResourceManager from a file on one of the worker threads.
+        /// The resource is committed into the ResourceManager with given \p mode once the load is completed.
+        /// Resource of IAsyncResourceLoader doesn't occupy a worker thread while it awaits its dependencies.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param fileName Path of the resource file to load.
+        /// \param mode Specifies store mode to use when the loaded resource is committed.
+        /// \return ResourceFuture that completes with the resource managed by ResourceManager.
+        template<class R>
+        ResourceFuture<R> AddFromFileAsync(const std::string &id, const std::string &fileName, CacheMode mode = CacheMode::Reuse);
+
+        /// Add resource to this instance of ResourceManager from a pointer of resource data on one of the worker threads.
+        /// The given \p data must remain valid until the returned ResourceFuture is completed.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param data Pointer of the resource data to load.
+        /// \param size Size of resource data, in bytes.
+        /// \param mode Specifies store mode to use when the loaded resource is committed.
+        /// \return ResourceFuture that completes with the resource managed by ResourceManager.
+        template<class R>
+        ResourceFuture<R> AddFromMemoryAsync(const std::string &id, void *data, std::size_t size, CacheMode mode = CacheMode::Update);
+
+        /// Add resource to this instance of ResourceManager from a stream on one of the worker threads.
+        /// The given \p stream must remain valid and must not be used by the caller until the returned ResourceFuture is completed.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param stream Input stream that contains the data of resource to load.
+        /// \param mode Specifies store mode to use when the loaded resource is committed.
+        /// \return ResourceFuture that completes with the resource managed by ResourceManager.
+        template<class R>
+        ResourceFuture<R> AddFromStreamAsync(const std::string &id, sf::InputStream &stream, CacheMode mode = CacheMode::Update);
+
+        /// Add resource to this instance of ResourceManager from a deserializer function on one of the worker threads.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param deserializer Resource deserialization function which describe how resource get loaded.
+        /// \param mode Specifies store mode to use when the loaded resource is committed.
+        /// \return ResourceFuture that completes with the resource managed by ResourceManager.
+        template<class R>
+        ResourceFuture<R> AddFromDeserializerAsync(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode = CacheMode::Update);
+
+        /// Set the number of worker threads that used to run asynchronous loads.
+        /// Pending loads of the current worker threads are completed before the worker threads get replaced.
+        /// \param count The number of worker threads, 0 to use the number of hardware threads.
+        void SetWorkerCount(std::size_t count);
+
+        /// Block the calling thread until every pending asynchronous load is completed.
+        void Wait();
+
+        /// Set whether the loaders should defer the upload of resources into the graphics device.
+        /// When enabled, loaders that support it (e.g. TextureLoader) only decode the resource, which is safe on worker threads,
+        /// and the resource stays empty until PumpUploads transfers it into the graphics device.
+        /// \param defer true to defer the uploads; otherwise, false to upload while loading.
+        void UseDeferredUploads(bool defer);
+
+        /// Gets a value indicating whether the loaders should defer the upload of resources into the graphics device.
+        /// \return true if the uploads are deferred; otherwise, false.
+        bool IsUploadDeferred() const;
+
+        /// Set the sink that perform the deferred uploads.
+        /// \param sink Sink to perform the uploads, nullptr to restore the default TextureUploadSink.
+        void SetUploadSink(std::shared_ptr<IUploadSink> sink);
+
+        /// Perform the pending uploads in FIFO order until either budget is exhausted.
+        /// At least one pending upload is performed per call, so large uploads can't stall the queue.
+        /// This must be called on the thread that owns the graphics context, typically once per frame.
+        /// Resource whose upload failed is kept empty rather than destroyed, since it may already be referenced, see IsUploadFailed.
+        /// \param budget Maximum amount of time to spend on uploads.
+        /// \param byteBudget Maximum amount of data to upload, in bytes.
+        /// \return The number of performed uploads.
+        std::size_t PumpUploads(sf::Time budget, std::size_t byteBudget = std::numeric_limits<std::size_t>::max());
+
+        /// Gets the number of uploads that waiting for PumpUploads.
+        /// \return The number of pending uploads.
+        std::size_t GetPendingUploadCount() const;
+
+        /// Gets the number of uploads that failed since this instance of ResourceManager is created.
+        /// \return The number of failed uploads.
+        std::size_t GetFailedUploadCount() const;
+
+        /// Gets a value indicating whether the deferred upload of resource that match with given type and id has failed.
+        /// The failure is cleared once the resource is replaced or loaded again.
+        /// \tparam R Type of Resource to check.
+        /// \param id ID of Resource to check.
+        /// \return true if the upload of the stored resource has failed; otherwise, false.
+        template<class R>
+        bool IsUploadFailed(const ResourceID &id) const;
+
         /// Find resource that match with given type and id.
+        /// Evicted resource is loaded again before it is returned.
         /// \tparam R Type of Resource to find.
         /// \param id ID of Resource to retrieve from this instance of ResourceContainer.
         /// \return pointer of Resource if there's resource that match with the given id, otherwise, nullptr.
         template<class R>
-        R *Find(const std::string &id) const;
+        R *Find(const ResourceID &id) const;
+
+        /// Find resource that referenced by given \p handle.
+        /// Evicted resource is loaded again before it is returned.
+        /// \tparam R Type of Resource to find.
+        /// \param handle Handle of Resource to retrieve from this instance of ResourceManager.
+        /// \return pointer of Resource if the handle is not stale, otherwise, nullptr.
+        template<class R>
+        R *Find(ResourceHandle<R> handle) const;
+
+        /// Set the eviction policy and memory budget for the given type of resource.
+        ///
+        /// \remark
+        /// Only resources that added from a file can be evicted, they are loaded again from the same file on the next Find or AddFromFile.
+        /// Pointers and references of unpinned resources may become dangling once another resource of the same type is added.
+        /// \tparam R Type of Resource to set the policy of.
+        /// \param policy Policy to select the resource to evict, EvictionPolicy::None to disable eviction.
+        /// \param budget Maximum estimated size of resources to held in memory, in bytes.
+        template<class R>
+        void SetEvictionPolicy(EvictionPolicy policy, std::size_t budget);
+
+        /// Gets the eviction counters of the given type of resource.
+        /// \tparam R Type of Resource to get the counters of.
+        /// \return The eviction counters of the given type of resource.
+        template<class R>
+        EvictionStats GetEvictionStats() const;
+
+        /// Gets a snapshot of the memory usage of resources inside this instance of ResourceManager.
+        /// The size of resources is estimated by ResourceSize.
+        /// \param largestCount The number of largest resources to include for each type of resource.
+        /// \return The memory usage of resources inside this instance of ResourceManager.
+        ResourceStats GetStats(std::size_t largestCount = 8) const;
+
+        /// Prevent resource that match with given type and id from being evicted until Unpin is called.
+        /// The resource is loaded again if it is already evicted.
+        /// \tparam R Type of Resource to pin.
+        /// \param id ID of Resource to pin.
+        /// \return pointer of pinned Resource if exists, otherwise, nullptr.
+        template<class R>
+        R *Pin(const ResourceID &id);
+
+        /// Release the pin of resource that match with given type and id.
+        /// \tparam R Type of Resource to unpin.
+        /// \param id ID of Resource to unpin.
+        /// \return true if resource is found and pinned, otherwise, false.
+        template<class R>
+        bool Unpin(const ResourceID &id);
+
+        /// Gets the handle of resource that match with given type and id.
+        /// \tparam R Type of Resource to get the handle of.
+        /// \param id ID of Resource to get the handle of.
+        /// \return Handle of the Resource if exists, otherwise, an invalid handle.
+        template<class R>
+        ResourceHandle<R> GetHandle(const ResourceID &id) const;
 
         /// Destroy resource from this instance of ResourceManager.
-        /// \param resource Resource to destroy from this instance of ResourceManager.
+        /// \param id ID of Resource to destroy from this instance of ResourceManager.
+        /// \return true if resource is found and removed from this instance of ResourceManager, otherwise, false.
+        template<class R>
+        bool Destroy(const ResourceID &id);
+
+        /// Destroy resource from this instance of ResourceManager.
+        /// \param handle Handle of Resource to destroy from this instance of ResourceManager.
         /// \return true if resource is found and removed from this instance of ResourceManager, otherwise, false.
         template<class R>
-        bool Destroy(const std::string &id);
+        bool Destroy(ResourceHandle<R> handle);
 
         /// Destroy resource from this instance of ResourceManager.
         /// \param resource Resource to destroy from this instance of ResourceManager.
@@ -156,12 +342,54 @@ namespace Gx
         bool Destroy(const R& resource);
 
         /// Destroy all resources inside this instance of ResourceManager.
+        /// Loads that are still in progress fail with ResourceStoreException.
         void Clear();
 
+        /// Set whether the dependencies between resources should be recorded into the DependencyGraph.
+        /// \param track true to record the dependencies and release them along with their dependents; otherwise, false.
+        void UseDependencyTracking(bool track);
+
+        /// Gets a snapshot of the recorded dependencies between resources.
+        /// \return Copy of the DependencyGraph of this instance of ResourceManager.
+        DependencyGraph GetDependencyGraph() const;
+
+        /// Save the recorded dependencies into a manifest file.
+        /// \param fileName Path of the manifest file in the disk.
+        /// \return true if the manifest is saved; otherwise, false.
+        bool SaveManifest(const std::string &fileName) const;
+
+        /// Load a manifest file and merge its dependencies into the DependencyGraph.
+        /// \param fileName Path of the manifest file in the disk.
+        /// \return true if the manifest is loaded; otherwise, false.
+        bool LoadManifest(const std::string &fileName);
+
+        /// Load every resource of the DependencyGraph that has a file name, each resource after its dependencies.
+        ///
+        /// \remark
+        /// Resources that don't depend on each other are loaded in parallel by the worker threads with CacheMode::Reuse,
+        /// so the loaders find their dependencies already stored. This function blocks until every resource is completed.
+        /// Only registered types of resource can be loaded, see Register. Resources of other types and dependency cycles are skipped,
+        /// they are loaded by their dependents as usual. The first exception is rethrown once every resource is completed.
+        /// \return The number of resources that successfully loaded.
+        std::size_t Preload();
+
     private:
+        friend class ResourceContext;
+        friend class ResourceScope;
+
+        template<class R>
+        friend class AcquireAwaiter;
+
         struct IManagedContainer
         {
             virtual ~IManagedContainer() = default;
+            virtual ResourceTypeStats GetStats(std::size_t largestCount) const = 0;
+            virtual std::size_t GetResidentBytes() const = 0;
+            virtual bool Untag(std::uint32_t index, std::uint32_t generation) = 0;
+            virtual bool Contains(const std::string &id) const = 0;
+            virtual bool Destroy(const std::string &id) = 0;
+            virtual std::string GetID(std::uint32_t index, std::uint32_t generation) const = 0;
+            virtual const char *GetTypeName() const = 0;
         };
 
         template<class R>
@@ -170,13 +398,172 @@ namespace Gx
             explicit ManagedContainer(std::unique_ptr<ResourceContainer<R>> container) : Container(std::move(container)) {};
             ~ManagedContainer() override { Container = nullptr; };
 
+            ResourceTypeStats GetStats(std::size_t largestCount) const override { return Container->GetStats(largestCount); }
+            std::size_t GetResidentBytes() const override { return Container->GetEvictionStats().ResidentBytes; }
+            bool Untag(std::uint32_t index, std::uint32_t generation) override { return Container->Untag(ResourceHandle<R>{ index, generation }); }
+            bool Contains(const std::string &id) const override { return Container->Contains(id); }
+            bool Destroy(const std::string &id) override { return Container->Destroy(id); }
+            std::string GetID(std::uint32_t index, std::uint32_t generation) const override { return Container->GetID(ResourceHandle<R>{ index, generation }); }
+            const char *GetTypeName() const override { return typeid(R).name(); }
+
             std::unique_ptr<ResourceContainer<R>> Container;
         };
-        using ContainerMap   = std::unordered_map<std::type_index, std::unique_ptr<IManagedContainer>>;
+        // Tracks a load that is being deserialized, so concurrent requests of the same resource can wait for it
+        struct InFlightLoad
+        {
+            std::mutex              Mutex;
+            std::condition_variable Completed;
+            std::thread::id         Owner;
+            bool                    Done     = false;
+            void                   *Resource = nullptr;
+            std::exception_ptr      Error;
+
+            std::vector<std::function<void()>> Continuations;
+        };
+
+        using InFlightKey = std::pair<std::size_t, std::string>;
+        struct InFlightKeyHash
+        {
+            std::size_t operator()(const InFlightKey &key) const;
+        };
+
+        using ContainerList  = std::vector<std::unique_ptr<IManagedContainer>>;
         using ContextFactory = std::function<std::unique_ptr<ResourceContext>(const std::string&, ResourceManager&)>;
+        using InFlightMap    = std::unordered_map<InFlightKey, std::shared_ptr<InFlightLoad>, InFlightKeyHash>;
+        using WaitMap        = std::unordered_map<std::thread::id, const InFlightLoad*>;
+
+        struct PendingUpload
+        {
+            std::size_t                       Bytes = 0;
+            std::function<void(IUploadSink&)> Upload;
+        };
+        using UploadQueue = std::deque<PendingUpload>;
+
+        // Type name and ID of the loads that wait for a load started on another thread
+        using LoadChain = std::vector<std::pair<std::string, std::string>>;
+
+        // Identifies the resource that is being deserialized by the calling thread, a frame without type is pushed by Preload
+        struct LoadFrame
+        {
+            const ResourceManager           *Manager;
+            const char                      *Type;
+            std::string_view                 ID;
+            std::shared_ptr<const LoadChain> Chain = nullptr;
+        };
+
+        // Pushes the frame for the lifetime of the instance
+        struct LoadScope
+        {
+            explicit LoadScope(const LoadFrame &frame) { GetLoadFrames().push_back(frame); }
+            ~LoadScope() { GetLoadFrames().pop_back(); }
+        };
+
+        struct GraphType
+        {
+            std::size_t Index;
+            void      (*Load)(ResourceManager &manager, const std::string &id, const std::string &fileName);
+        };
+        using GraphTypeMap = std::unordered_map<std::string, GraphType>;
+
+        static std::size_t AllocateTypeIndex();
+
+        template<class R>
+        static std::size_t GetTypeIndex();
+
+        template<class R>
+        ResourceContainer<R> &GetContainer();
+
+        template<class R>
+        ResourceContainer<R> *FindContainer() const;
+
+        template<class R>
+        ResourceContainer<R> &RequireContainer(const std::string &id) const;
+
+        template<class R>
+        std::function<std::unique_ptr<R>()> CreateFileLoader(const std::string &id, const std::string &fileName);
+
+        template<class R, class Key>
+        R *Reload(const Key &key) const;
+
+        template<class R>
+        R &Commit(const std::string &id, const std::function<std::unique_ptr<R>()> &deserializer, CacheMode mode, std::function<std::unique_ptr<R>()> reloader = nullptr, std::size_t sourceSize = 0);
+
+        template<class R>
+        ResourceFuture<R> CommitAsync(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode, std::function<std::unique_ptr<R>()> reloader = nullptr, std::size_t sourceSize = 0);
+
+#ifdef GENODE_IO_HAS_COROUTINES
+        template<class R>
+        struct TaskLoad;
+
+        template<class R>
+        ResourceFuture<R> CommitTask(const std::string &id, const std::string &fileName, std::unique_ptr<IResourceLoader<R>> loader, CacheMode mode);
+#endif
+
+        template<class R>
+        static std::size_t GetSourceSize(const std::string &fileName);
+
+        template<class R>
+        R *Await(const std::string &id) const;
+
+        template<class R>
+        ResourceHandle<R> Tag(const ResourceID &id, const R *resource = nullptr);
+
+        template<class R>
+        static void LoadDependency(ResourceManager &manager, const std::string &id, const std::string &fileName);
+
+        template<class R>
+        void RecordDependency(const std::string &id);
+
+        template<class R>
+        void RecordSource(const std::string &id, const std::string &fileName);
+
+        template<class R>
+        void RecordLoad(const std::string &id);
+
+        static std::vector<LoadFrame> &GetLoadFrames();
+        const LoadFrame *GetCurrentLoad() const;
+        std::shared_ptr<const LoadChain> CaptureChain() const;
+        bool IsAwaitedBy(const char *type, const std::string &id) const;
+        void ReleaseDependencies(const std::string &type, const std::string &id);
+
+        template<class R>
+        void StageUpload(const std::string &id, R &resource, std::size_t bytes, std::function<bool(IUploadSink&, R&)> upload);
+
+        static std::vector<PendingUpload> &GetStagedUploads();
+        void PublishUploads(std::size_t mark) const;
+        static void DiscardUploads(std::size_t mark);
+        void EnqueueUploads(std::vector<PendingUpload> &uploads) const;
+
+        std::shared_ptr<InFlightLoad> JoinLoad(std::size_t type, const std::string &id, bool &owner);
+        std::shared_ptr<InFlightLoad> FindLoad(std::size_t type, const std::string &id) const;
+        void CompleteLoad(std::size_t type, const std::string &id, InFlightLoad &load, void *resource, std::exception_ptr error);
+        void DetachLoad(InFlightLoad &load);
+        static void ContinueLoad(InFlightLoad &load, std::function<void()> continuation);
+        void *WaitLoad(InFlightLoad &load, const std::string &id) const;
+
+        void UpdatePeak() const;
+
+        ThreadPool &GetWorkers();
 
-        ContainerMap   m_containers;
-        ContextFactory m_contextFactory;
+        ContainerList                m_containers;
+        ContextFactory               m_contextFactory;
+        mutable std::shared_mutex    m_mutex;
+        std::shared_ptr<ThreadPool>  m_workers;
+        std::size_t                  m_workerCount;
+        std::mutex                   m_workersMutex;
+        mutable std::size_t          m_peakBytes;
+        InFlightMap                  m_inFlight;
+        mutable WaitMap              m_waits;
+        mutable std::mutex           m_inFlightMutex;
+        mutable UploadQueue          m_uploads;
+        std::shared_ptr<IUploadSink> m_uploadSink;
+        mutable std::mutex           m_uploadsMutex;
+        std::atomic<bool>            m_deferUploads;
+        std::atomic<std::size_t>     m_failedUploads;
+        DependencyGraph              m_graph;
+        GraphTypeMap                 m_graphTypes;
+        mutable std::mutex           m_graphMutex;
+        std::atomic<bool>            m_trackDependencies;
     };
 }
 
@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <type_traits>
+
+#include <Genode/IO/IAsyncResourceLoader.hpp>
 #include <Genode/IO/ResourceLoaderFactory.hpp>
 #include <Genode/IO/ResourceContext.hpp>
+#include <Genode/IO/Instrumentation.hpp>
 #include "ResourceManager.hpp"
 
 
@@ -8,16 +13,20 @@ namespace Gx
     template<class R>
     void ResourceManager::Register()
     {
-        if (m_containers.find(typeid(R)) != m_containers.end())
-            return;
-
-        m_containers[typeid(R)] = std::make_unique<ManagedContainer<R>>(std::make_unique<ResourceContainer<R>>());
+        GetContainer<R>();
     }
 
     template<class R>
     bool ResourceManager::Release()
     {
-        return m_containers.erase(typeid(R)) != 0;
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto index = GetTypeIndex<R>();
+        if (index >= m_containers.size() || !m_containers[index])
+            return false;
+
+        m_containers[index] = nullptr;
+        return true;
     }
 
     template<class R>
@@ -25,7 +34,10 @@ namespace Gx
     {
         Register<R>();
 
-        auto resource = Find<R>(id);
+        // The container is resolved under the lock, Release may destroy it once the lock is released
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto container = FindContainer<R>();
+        auto resource  = container ? container->Find(id) : nullptr;
         if (!resource)
             return nullptr;
 
@@ -65,7 +77,7 @@ namespace Gx
     {
         Register<R>();
 
-        auto resource = &AddFromStream<R>(id, deserializer, CacheMode::Reuse);
+        auto resource = &AddFromDeserializer<R>(id, deserializer, CacheMode::Reuse);
         return std::make_unique<R>(*resource);
     }
 
@@ -74,17 +86,8 @@ namespace Gx
     {
         Register<R>();
 
-        auto loader = ResourceLoaderFactory::CreateResourceLoaderFor<R>();
-        if (!loader)
-            throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
-
-        auto managed = static_cast<ManagedContainer<R>*>(m_containers[typeid(R)].get());
-        auto deserializer = [&, this] () {
-            auto ctx = std::move(m_contextFactory(id, *this));
-            return loader->LoadFromFile(fileName, *ctx);
-        };
-
-        return managed->Container->Store(id, deserializer, mode);
+        auto loader = CreateFileLoader<R>(id, fileName);
+        return Commit<R>(id, loader, mode, loader, GetSourceSize<R>(fileName));
     }
 
     template<class R>
@@ -92,17 +95,16 @@ namespace Gx
     {
         Register<R>();
 
-        auto loader = ResourceLoaderFactory::CreateResourceLoaderFor<R>();
+        auto loader = ResourceLoaderFactory::AcquireResourceLoaderFor<R>();
         if (!loader)
             throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
 
-        auto managed = static_cast<ManagedContainer<R>*>(m_containers[typeid(R)].get());
         auto deserializer = [&, this] () {
             auto ctx = std::move(m_contextFactory(id, *this));
             return loader->LoadFromMemory(data, size, *ctx);
         };
 
-        return managed->Container->Store(id, deserializer, mode);
+        return Commit<R>(id, deserializer, mode, nullptr, size);
     }
 
     template<class R>
@@ -110,17 +112,17 @@ namespace Gx
     {
         Register<R>();
 
-        auto loader = ResourceLoaderFactory::CreateResourceLoaderFor<R>();
+        auto loader = ResourceLoaderFactory::AcquireResourceLoaderFor<R>();
         if (!loader)
             throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
 
-        auto managed = static_cast<ManagedContainer<R>*>(m_containers[typeid(R)].get());
         auto deserializer = [&, this] () {
             auto ctx = std::move(m_contextFactory(id, *this));
             return loader->LoadFromStream(stream, *ctx);
         };
 
-        return &managed->Container->Store(id, deserializer, mode);
+        auto sourceSize = ResourceSize<R>::UseSourceSize ? static_cast<std::size_t>(std::max<sf::Int64>(stream.getSize(), 0)) : 0;
+        return Commit<R>(id, deserializer, mode, nullptr, sourceSize);
     }
 
     template<class R>
@@ -128,43 +130,800 @@ namespace Gx
     {
         Register<R>();
 
-        auto managed = static_cast<ManagedContainer<R>*>(m_containers[typeid(R)].get());
-        auto &result = managed->Container->Store(id, deserializer, mode);
+        return Commit<R>(id, deserializer, mode);
+    }
+
+    template<class R>
+    ResourceFuture<R> ResourceManager::AddFromFileAsync(const std::string &id, const std::string &fileName, CacheMode mode)
+    {
+        Register<R>();
+
+#ifdef GENODE_IO_HAS_COROUTINES
+        // The coroutine may be resumed on another worker thread, so it gets its own loader instead of the cached one of this thread
+        auto async = ResourceLoaderFactory::CreateResourceLoaderFor<R>();
+        if (dynamic_cast<IAsyncResourceLoader<R>*>(async.get()))
+            return CommitTask<R>(id, fileName, std::move(async), mode);
+#endif
 
-        return result;
+        auto loader = CreateFileLoader<R>(id, fileName);
+        return CommitAsync<R>(id, loader, mode, loader, GetSourceSize<R>(fileName));
     }
 
     template<class R>
-    R *ResourceManager::Find(const std::string &id) const
+    ResourceFuture<R> ResourceManager::AddFromMemoryAsync(const std::string &id, void *data, std::size_t size, CacheMode mode)
     {
-        auto it = m_containers.find(typeid(R));
-        if (it == m_containers.end())
-            return nullptr;
+        Register<R>();
+
+        return CommitAsync<R>(id, [this, id, data, size] () {
+            auto loader = ResourceLoaderFactory::AcquireResourceLoaderFor<R>();
+            if (!loader)
+                throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
 
-        auto managed = dynamic_cast<ManagedContainer<R>*>(it->second.get());
+            auto ctx = std::move(m_contextFactory(id, *this));
+            return loader->LoadFromMemory(data, size, *ctx);
+        }, mode, nullptr, size);
+    }
+
+    template<class R>
+    ResourceFuture<R> ResourceManager::AddFromStreamAsync(const std::string &id, sf::InputStream &stream, CacheMode mode)
+    {
+        Register<R>();
+
+        auto sourceSize = ResourceSize<R>::UseSourceSize ? static_cast<std::size_t>(std::max<sf::Int64>(stream.getSize(), 0)) : 0;
+        return CommitAsync<R>(id, [this, id, &stream] () {
+            auto loader = ResourceLoaderFactory::AcquireResourceLoaderFor<R>();
+            if (!loader)
+                throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
+
+            auto ctx = std::move(m_contextFactory(id, *this));
+            return loader->LoadFromStream(stream, *ctx);
+        }, mode, nullptr, sourceSize);
+    }
+
+    template<class R>
+    ResourceFuture<R> ResourceManager::AddFromDeserializerAsync(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode)
+    {
+        Register<R>();
+
+        return CommitAsync<R>(id, std::move(deserializer), mode);
+    }
+
+    template<class R>
+    R *ResourceManager::Find(const ResourceID &id) const
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+            auto container = FindContainer<R>();
+            if (!container)
+                return nullptr;
+
+            if (auto resource = container->Find(id))
+                return resource;
+        }
+
+        return Reload<R>(id);
+    }
+
+    template<class R>
+    R *ResourceManager::Find(ResourceHandle<R> handle) const
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+            auto container = FindContainer<R>();
+            if (!container)
+                return nullptr;
+
+            if (auto resource = container->Find(handle))
+                return resource;
+        }
+
+        return Reload<R>(handle);
+    }
+
+    template<class R>
+    void ResourceManager::SetEvictionPolicy(EvictionPolicy policy, std::size_t budget)
+    {
+        Register<R>();
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (auto container = FindContainer<R>())
+            container->SetEvictionPolicy(policy, budget);
+    }
+
+    template<class R>
+    EvictionStats ResourceManager::GetEvictionStats() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return {};
+
+        return container->GetEvictionStats();
+    }
+
+    template<class R>
+    R *ResourceManager::Pin(const ResourceID &id)
+    {
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+            auto container = FindContainer<R>();
+            if (!container || !container->Pin(id))
+                return nullptr;
+        }
+
+        // Pinned resource is no longer evicted, once it is reloaded it stays in memory
+        return Find<R>(id);
+    }
+
+    template<class R>
+    bool ResourceManager::Unpin(const ResourceID &id)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return false;
+
+        return container->Unpin(id);
+    }
+
+    template<class R>
+    ResourceHandle<R> ResourceManager::GetHandle(const ResourceID &id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return {};
+
+        return container->GetHandle(id);
+    }
+
+    template<class R>
+    bool ResourceManager::Destroy(const R &resource)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return false;
+
+        auto id = m_trackDependencies ? container->GetID(resource) : std::string();
+        if (!container->Destroy(resource))
+            return false;
+
+        if (!id.empty())
+            ReleaseDependencies(typeid(R).name(), id);
+
+        return true;
+    }
+
+    template<class R>
+    bool ResourceManager::Destroy(const ResourceID &id)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container || !container->Destroy(id))
+            return false;
+
+        if (m_trackDependencies)
+            ReleaseDependencies(typeid(R).name(), std::string(id.GetName()));
+
+        return true;
+    }
+
+    template<class R>
+    bool ResourceManager::Destroy(ResourceHandle<R> handle)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return false;
+
+        auto id = m_trackDependencies ? container->GetID(handle) : std::string();
+        if (!container->Destroy(handle))
+            return false;
+
+        if (!id.empty())
+            ReleaseDependencies(typeid(R).name(), id);
+
+        return true;
+    }
+
+    template<class R>
+    std::size_t ResourceManager::GetTypeIndex()
+    {
+        static const std::size_t index = AllocateTypeIndex();
+        return index;
+    }
+
+    template<class R>
+    ResourceContainer<R> &ResourceManager::GetContainer()
+    {
+        auto index = GetTypeIndex<R>();
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (index < m_containers.size() && m_containers[index])
+                return *static_cast<ManagedContainer<R>*>(m_containers[index].get())->Container;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (index >= m_containers.size())
+            m_containers.resize(index + 1);
+
+        auto &managed = m_containers[index];
         if (!managed)
+        {
+            managed = std::make_unique<ManagedContainer<R>>(std::make_unique<ResourceContainer<R>>());
+
+            // Registered types can be loaded by Preload
+            std::lock_guard<std::mutex> graphLock(m_graphMutex);
+            m_graphTypes[typeid(R).name()] = { index, &LoadDependency<R> };
+        }
+
+        return *static_cast<ManagedContainer<R>*>(managed.get())->Container;
+    }
+
+    template<class R>
+    ResourceContainer<R> *ResourceManager::FindContainer() const
+    {
+        // The caller must hold m_mutex
+        // Each type has its own index, so the slot can only be occupied by the container of R
+        auto index = GetTypeIndex<R>();
+        if (index >= m_containers.size() || !m_containers[index])
             return nullptr;
 
-        return managed->Container->Find(id);
+        return static_cast<ManagedContainer<R>*>(m_containers[index].get())->Container.get();
     }
 
     template<class R>
-    bool ResourceManager::Destroy(const R &resource)
+    ResourceContainer<R> &ResourceManager::RequireContainer(const std::string &id) const
+    {
+        // The caller must hold m_mutex
+        // The container may be destroyed by Release or Clear while the lock is released during a load
+        auto container = FindContainer<R>();
+        if (!container)
+            throw ResourceStoreException(id, "[" + id + "] Resource type is released while the resource is loaded.");
+
+        return *container;
+    }
+
+    template<class R>
+    std::function<std::unique_ptr<R>()> ResourceManager::CreateFileLoader(const std::string &id, const std::string &fileName)
+    {
+        RecordSource<R>(id, fileName);
+        return [this, id, fileName] () {
+            auto loader = ResourceLoaderFactory::AcquireResourceLoaderFor<R>();
+            if (!loader)
+                throw ResourceLoadException("There's no [ResourceLoader] for [" + std::string(typeid(R).name()) + "] type.");
+
+            auto ctx = std::move(m_contextFactory(id, *this));
+            return loader->LoadFromFile(fileName, *ctx);
+        };
+    }
+
+    template<class R>
+    std::size_t ResourceManager::GetSourceSize(const std::string &fileName)
+    {
+        // Only query the file system when the estimation make use of it
+        if (!ResourceSize<R>::UseSourceSize)
+            return 0;
+
+        auto size = FileSystem::GetFileSize(fileName);
+        return size == static_cast<std::size_t>(-1) ? 0 : size;
+    }
+
+    template<class R, class Key>
+    R *ResourceManager::Reload(const Key &key) const
     {
-        auto it = m_containers.find(typeid(R));
-        if (it == m_containers.end())
+        ResourceContainer<R> *container;
+        std::function<std::unique_ptr<R>()> reloader;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+            container = FindContainer<R>();
+            if (!container)
+                return nullptr;
+
+            reloader = container->GetReloader(key);
+            if (!reloader)
+                return container->Find(key);
+        }
+
+        // Same as Commit, the lock is released while deserializing
+        auto uploads = GetStagedUploads().size();
+        std::unique_ptr<R> resource;
+        try
+        {
+            // Dependencies can only be attributed to the resource when its ID is known
+            auto frame = LoadFrame{ this, nullptr, {} };
+            if constexpr (std::is_same_v<Key, ResourceID>)
+                frame = LoadFrame{ this, typeid(R).name(), key.GetName() };
+
+            LoadScope scope(frame);
+            auto start = Instrumentation::Start();
+            resource   = reloader();
+            if constexpr (std::is_same_v<Key, ResourceID>)
+                Instrumentation::RecordLoad(typeid(R), key.GetName(), start);
+            else
+                Instrumentation::RecordLoad(typeid(R), {}, start);
+        }
+        catch (...)
+        {
+            DiscardUploads(uploads);
+            throw;
+        }
+
+        R *restored = nullptr;
+        {
+            // The container is gone if the type is released while deserializing
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            container = FindContainer<R>();
+            if (container)
+            {
+                restored = container->Restore(key, std::move(resource));
+                UpdatePeak();
+            }
+        }
+
+        if (!restored)
+        {
+            DiscardUploads(uploads);
+            return nullptr;
+        }
+
+        PublishUploads(uploads);
+        return restored;
+    }
+
+    template<class R>
+    R &ResourceManager::Commit(const std::string &id, const std::function<std::unique_ptr<R>()> &deserializer, CacheMode mode, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize)
+    {
+        RecordLoad<R>(id);
+
+        // The lock is released while deserializing so the loader can resolve its dependencies through ResourceContext,
+        // the container is resolved again whenever the lock is acquired
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            auto &container = RequireContainer<R>(id);
+            if (mode == CacheMode::Allocate && container.Contains(id))
+                throw ResourceStoreException(id, "[" + id + "] Resource with same ID is already exists.");
+
+            if (mode == CacheMode::Reuse)
+            {
+                if (auto current = container.Find(id))
+                {
+                    Instrumentation::RecordLookup(typeid(R), id, true);
+                    return *current;
+                }
+            }
+        }
+
+        // Only the first request deserializes the resource, the others wait for its result
+        std::shared_ptr<InFlightLoad> load;
+        if (mode == CacheMode::Reuse)
+        {
+            bool owner;
+            load = JoinLoad(GetTypeIndex<R>(), id, owner);
+            if (!owner)
+            {
+                if (IsAwaitedBy(typeid(R).name(), id))
+                    throw ResourceLoadException("[" + id + "] Resource depends on itself.");
+
+                Instrumentation::RecordLookup(typeid(R), id, true);
+                return *static_cast<R*>(WaitLoad(*load, id));
+            }
+
+            // Previous load may have been completed between the lookup and joining the load
+            R *current;
+            try
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                current = RequireContainer<R>(id).Find(id);
+            }
+            catch (...)
+            {
+                CompleteLoad(GetTypeIndex<R>(), id, *load, nullptr, std::current_exception());
+                throw;
+            }
+
+            if (current)
+            {
+                CompleteLoad(GetTypeIndex<R>(), id, *load, current, nullptr);
+                Instrumentation::RecordLookup(typeid(R), id, true);
+                return *current;
+            }
+        }
+
+        // Uploads staged by the loader are only published once the resource is stored
+        auto uploads = GetStagedUploads().size();
+        try
+        {
+            Instrumentation::RecordLookup(typeid(R), id, false);
+            std::unique_ptr<R> resource;
+            {
+                LoadScope scope({ this, typeid(R).name(), id });
+                auto start = Instrumentation::Start();
+                resource   = deserializer();
+                Instrumentation::RecordLoad(typeid(R), id, start);
+            }
+
+            R *stored;
+            {
+                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                stored = &RequireContainer<R>(id).Store(id, std::move(resource), mode, std::move(reloader), sourceSize);
+                UpdatePeak();
+            }
+
+            PublishUploads(uploads);
+            if (load)
+                CompleteLoad(GetTypeIndex<R>(), id, *load, stored, nullptr);
+
+            return *stored;
+        }
+        catch (...)
+        {
+            DiscardUploads(uploads);
+            if (load)
+                CompleteLoad(GetTypeIndex<R>(), id, *load, nullptr, std::current_exception());
+
+            throw;
+        }
+    }
+
+    template<class R>
+    void ResourceManager::StageUpload(const std::string &id, R &resource, std::size_t bytes, std::function<bool(IUploadSink&, R&)> upload)
+    {
+        auto target = &resource;
+        GetStagedUploads().push_back({ bytes, [this, id, target, upload = std::move(upload)] (IUploadSink &sink) {
+            // The resource may be destroyed, replaced or evicted before the upload get pumped,
+            // the shared lock keeps it alive until the upload is completed
+            bool uploaded;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                auto container = FindContainer<R>();
+                if (!container || container->Find(id) != target)
+                    return;
+
+                uploaded = upload(sink, *target);
+            }
+
+            // The resource is stored before its data is uploaded, so its size is only known now
+            // Failed resource is kept, the caller may already hold a reference to it
+            if (!uploaded)
+                m_failedUploads++;
+
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            auto container = FindContainer<R>();
+            if (!container)
+                return;
+
+            if (!uploaded)
+                container->MarkFailed(id, target);
+            else if (container->Remeasure(id, target))
+                UpdatePeak();
+        }});
+    }
+
+    template<class R>
+    bool ResourceManager::IsUploadFailed(const ResourceID &id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
             return false;
 
-        auto managed = static_cast<ManagedContainer<R>*>(it->second.get());
-        return managed->Container->Destroy(resource);
+        auto slot = container->FindSlot(id);
+        return slot && slot->Failed;
     }
 
     template<class R>
-    bool ResourceManager::Destroy(const std::string &id)
+    R *ResourceManager::Await(const std::string &id) const
     {
-        Register<R>();
+        auto load = FindLoad(GetTypeIndex<R>(), id);
+        if (!load)
+            return nullptr;
+
+        if (IsAwaitedBy(typeid(R).name(), id))
+            throw ResourceLoadException("[" + id + "] Resource depends on itself.");
+
+        return static_cast<R*>(WaitLoad(*load, id));
+    }
+
+    template<class R>
+    ResourceHandle<R> ResourceManager::Tag(const ResourceID &id, const R *resource)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto container = FindContainer<R>();
+        if (!container)
+            return {};
+
+        return container->Tag(id, resource);
+    }
+
+    template<class R>
+    void ResourceManager::LoadDependency(ResourceManager &manager, const std::string &id, const std::string &fileName)
+    {
+        manager.AddFromFile<R>(id, fileName, CacheMode::Reuse);
+    }
+
+    template<class R>
+    void ResourceManager::RecordDependency(const std::string &id)
+    {
+        if (!m_trackDependencies)
+            return;
+
+        // Dependencies acquired outside of a load have no dependent to attribute to
+        auto current = GetCurrentLoad();
+        if (!current || !current->Type)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        auto dependent  = m_graph.Insert(current->Type, std::string(current->ID));
+        auto dependency = m_graph.Insert(typeid(R).name(), id);
+        m_graph.Connect(dependent, dependency);
+    }
+
+    template<class R>
+    void ResourceManager::RecordSource(const std::string &id, const std::string &fileName)
+    {
+        if (!m_trackDependencies)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        m_graph.GetNode(m_graph.Insert(typeid(R).name(), id)).FileName = fileName;
+    }
+
+    template<class R>
+    void ResourceManager::RecordLoad(const std::string &id)
+    {
+        // Only the resources that requested outside of another load are added directly
+        if (!m_trackDependencies || GetCurrentLoad())
+            return;
+
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        m_graph.GetNode(m_graph.Insert(typeid(R).name(), id)).Explicit = true;
+    }
+
+    template<class R>
+    ResourceFuture<R> ResourceManager::CommitAsync(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode, std::function<std::unique_ptr<R>()> reloader, std::size_t sourceSize)
+    {
+        // Loads that started by another load are its dependencies rather than added directly
+        auto frame  = GetCurrentLoad() ? LoadFrame{ this, nullptr, {}, CaptureChain() } : LoadFrame{ nullptr, nullptr, {} };
+        auto future = ResourceFuture<R>(std::make_shared<typename ResourceFuture<R>::State>());
+        GetWorkers().Enqueue([this, id, deserializer = std::move(deserializer), mode, reloader = std::move(reloader), sourceSize, future, frame] () {
+            try
+            {
+                LoadScope scope(frame);
+                future.SetResult(Commit<R>(id, deserializer, mode, reloader, sourceSize));
+            }
+            catch (...)
+            {
+                future.SetException(std::current_exception());
+            }
+        });
+
+        return future;
+    }
+
+#ifdef GENODE_IO_HAS_COROUTINES
+    // State of a load that deserialized by the coroutine of IAsyncResourceLoader, it keeps itself alive while the coroutine is suspended
+    template<class R>
+    struct ResourceManager::TaskLoad final : public LoadScheduler, public std::enable_shared_from_this<TaskLoad<R>>
+    {
+        void Start();
+        void Run(std::coroutine_handle<> handle);
+        void Complete();
+        void Fail(std::exception_ptr error);
+
+        void Suspend() override;
+        void Resume(std::coroutine_handle<> handle) override;
+
+        ResourceManager                    *Manager    = nullptr;
+        std::string                         ID;
+        std::string                         FileName;
+        CacheMode                           Mode       = CacheMode::Reuse;
+        std::size_t                         SourceSize = 0;
+        bool                                Nested     = false;
+        std::unique_ptr<IResourceLoader<R>> Loader;
+        std::unique_ptr<ResourceContext>    Context;
+        LoadTask<std::unique_ptr<R>>        Task;
+        std::shared_ptr<InFlightLoad>       InFlight;
+        ResourceFuture<R>                   Future;
+        std::vector<PendingUpload>          Uploads;
+        std::size_t                         Mark       = 0;
+        std::shared_ptr<const LoadChain>    Chain;
+        Instrumentation::TimePoint          StartTime;
+        std::shared_ptr<TaskLoad>           Self;
+    };
+
+    template<class R>
+    ResourceFuture<R> ResourceManager::CommitTask(const std::string &id, const std::string &fileName, std::unique_ptr<IResourceLoader<R>> loader, CacheMode mode)
+    {
+        RecordSource<R>(id, fileName);
+
+        auto load        = std::make_shared<TaskLoad<R>>();
+        load->Manager    = this;
+        load->ID         = id;
+        load->FileName   = fileName;
+        load->Mode       = mode;
+        load->SourceSize = GetSourceSize<R>(fileName);
+        load->Nested     = GetCurrentLoad() != nullptr;
+        load->Chain      = CaptureChain();
+        load->Loader     = std::move(loader);
+        load->Future     = ResourceFuture<R>(std::make_shared<typename ResourceFuture<R>::State>());
+
+        auto future = load->Future;
+        GetWorkers().Enqueue([load] () {
+            load->Start();
+        });
+
+        return future;
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Start()
+    {
+        // Same as Commit, except the coroutine is not awaited by this thread
+        try
+        {
+            if (!Nested)
+                Manager->RecordLoad<R>(ID);
+
+            {
+                std::shared_lock<std::shared_mutex> lock(Manager->m_mutex);
+                auto &container = Manager->RequireContainer<R>(ID);
+                if (Mode == CacheMode::Allocate && container.Contains(ID))
+                    throw ResourceStoreException(ID, "[" + ID + "] Resource with same ID is already exists.");
+
+                if (Mode == CacheMode::Reuse)
+                {
+                    if (auto current = container.Find(ID))
+                    {
+                        Instrumentation::RecordLookup(typeid(R), ID, true);
+                        Future.SetResult(*current);
+                        return;
+                    }
+                }
+            }
+
+            if (Mode == CacheMode::Reuse)
+            {
+                bool owner;
+                auto load = Manager->JoinLoad(GetTypeIndex<R>(), ID, owner);
+                if (!owner)
+                {
+                    // The ongoing load may be one of the loads that await this one, directly or through other loads
+                    if (Chain && std::any_of(Chain->begin(), Chain->end(), [this] (auto &link) { return link.first == typeid(R).name() && link.second == ID; }))
+                        throw ResourceLoadException("[" + ID + "] Resource depends on itself.");
+
+                    // Completed along with the ongoing load rather than waiting for it on this worker thread
+                    Instrumentation::RecordLookup(typeid(R), ID, true);
+                    ContinueLoad(*load, [load, future = Future] () {
+                        if (load->Error)
+                            future.SetException(load->Error);
+                        else
+                            future.SetResult(*static_cast<R*>(load->Resource));
+                    });
+
+                    return;
+                }
+
+                InFlight = std::move(load);
+                Manager->DetachLoad(*InFlight);
+
+                R *current;
+                {
+                    std::shared_lock<std::shared_mutex> lock(Manager->m_mutex);
+                    current = Manager->RequireContainer<R>(ID).Find(ID);
+                }
+
+                if (current)
+                {
+                    Manager->CompleteLoad(GetTypeIndex<R>(), ID, *InFlight, current, nullptr);
+                    Instrumentation::RecordLookup(typeid(R), ID, true);
+                    Future.SetResult(*current);
+                    return;
+                }
+            }
+
+            Instrumentation::RecordLookup(typeid(R), ID, false);
+            StartTime = Instrumentation::Start();
+
+            Context = Manager->m_contextFactory(ID, *Manager);
+            Context->m_scheduler = this;
+
+            Task = static_cast<IAsyncResourceLoader<R>&>(*Loader).LoadFromFileAsync(FileName, *Context);
+            Task.GetHandle().promise().Completed = [this] () {
+                Complete();
+            };
+        }
+        catch (...)
+        {
+            Fail(std::current_exception());
+            return;
+        }
 
-        auto managed = static_cast<ManagedContainer<R>*>(m_containers[typeid(R)].get());
-        return managed->Container->Destroy(id);
+        Self = this->shared_from_this();
+        Run(Task.GetHandle());
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Run(std::coroutine_handle<> handle)
+    {
+        // The caller keeps this instance alive, the coroutine may be completed (or suspended again) once it returns
+        LoadScope scope({ Manager, typeid(R).name(), ID, Chain });
+        Mark = GetStagedUploads().size();
+        handle.resume();
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Complete()
+    {
+        Suspend();
+        auto self = std::move(Self);
+
+        try
+        {
+            auto resource = Task.Get();
+            Instrumentation::RecordLoad(typeid(R), ID, StartTime);
+
+            auto reloader = Manager->CreateFileLoader<R>(ID, FileName);
+
+            R *stored;
+            {
+                std::unique_lock<std::shared_mutex> lock(Manager->m_mutex);
+                stored = &Manager->RequireContainer<R>(ID).Store(ID, std::move(resource), Mode, std::move(reloader), SourceSize);
+                Manager->UpdatePeak();
+            }
+
+            Manager->EnqueueUploads(Uploads);
+            if (InFlight)
+                Manager->CompleteLoad(GetTypeIndex<R>(), ID, *InFlight, stored, nullptr);
+
+            Future.SetResult(*stored);
+        }
+        catch (...)
+        {
+            Uploads.clear();
+            Fail(std::current_exception());
+        }
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Fail(std::exception_ptr error)
+    {
+        if (InFlight)
+            Manager->CompleteLoad(GetTypeIndex<R>(), ID, *InFlight, nullptr, error);
+
+        Future.SetException(std::move(error));
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Suspend()
+    {
+        // Uploads staged by this segment of the coroutine are carried along until the resource is stored
+        auto &staged = GetStagedUploads();
+        for (auto i = Mark; i < staged.size(); i++)
+            Uploads.push_back(std::move(staged[i]));
+
+        DiscardUploads(Mark);
+    }
+
+    template<class R>
+    void ResourceManager::TaskLoad<R>::Resume(std::coroutine_handle<> handle)
+    {
+        Manager->GetWorkers().Enqueue([self = this->shared_from_this(), handle] () {
+            self->Run(handle);
+        });
     }
-}
\ No newline at end of file
+#endif
+}
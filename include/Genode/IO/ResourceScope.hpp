@@ -0,0 +1,150 @@
+#ifndef GENODE_RESOURCE_SCOPE_HPP
+#define GENODE_RESOURCE_SCOPE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Genode/IO/ResourceManager.hpp>
+
+namespace Gx
+{
+    /// Represents a group of resources inside a ResourceManager that released together, e.g. the resources of a scene.
+    ///
+    /// \remark
+    /// Resources that added through the scope are tagged with it, releasing the scope destroys all of them in a single pass
+    /// across every ResourceContainer of the ResourceManager. The scope only keeps a 12 bytes record per resource,
+    /// records are allocated from fixed-size blocks that reused after the scope is released.
+    ///
+    /// A resource that tagged by multiple scopes (e.g. added with CacheMode::Reuse by two scenes) is destroyed by the last released scope.
+    /// Resources can still be destroyed individually through the ResourceManager, the scope simply skips them once it is released.
+    /// The ResourceManager must outlive its scopes.
+    class ResourceScope final : private NonCopyable
+    {
+    public:
+        /// Represents a resource to preload as part of a batch.
+        struct Entry
+        {
+            using Loader = std::function<void()> (*)(ResourceScope &scope, const Entry &entry);
+
+            /// Value to identify the resource.
+            std::string ID;
+
+            /// Path of the resource file to load.
+            std::string FileName;
+
+            /// Function that start the load of the resource type, it returns the function that complete the load.
+            Loader Load = nullptr;
+        };
+
+        /// Initializes a new instance of ResourceScope.
+        /// \param manager The ResourceManager that the resources are added to.
+        explicit ResourceScope(ResourceManager &manager);
+
+        /// Release the resources that tagged with this instance of ResourceScope.
+        ~ResourceScope();
+
+        /// Create an Entry of given type of resource to pass into Preload.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param fileName Path of the resource file to load.
+        /// \return The Entry that describe the resource.
+        template<class R>
+        static Entry CreateEntry(const std::string &id, const std::string &fileName);
+
+        /// Gets the ResourceManager that the resources are added to.
+        ResourceManager &GetManager() const;
+
+        /// Add resource to the ResourceManager from a file and tag it with this instance of ResourceScope.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param fileName Path of the resource file to load.
+        /// \param mode Specifies store mode to use when the resource is stored.
+        /// \return Reference to the resource that managed by ResourceManager.
+        template<class R>
+        R &AddFromFile(const std::string &id, const std::string &fileName, CacheMode mode = CacheMode::Reuse);
+
+        /// Add resource to the ResourceManager from a pointer of resource data and tag it with this instance of ResourceScope.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param data Pointer of the resource data to load.
+        /// \param size Size of resource data, in bytes.
+        /// \param mode Specifies store mode to use when the resource is stored.
+        /// \return Reference to the resource that managed by ResourceManager.
+        template<class R>
+        R &AddFromMemory(const std::string &id, void *data, std::size_t size, CacheMode mode = CacheMode::Update);
+
+        /// Add resource to the ResourceManager from a stream and tag it with this instance of ResourceScope.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param stream Input stream that contains the data of resource to load.
+        /// \param mode Specifies store mode to use when the resource is stored.
+        /// \return Reference to the resource that managed by ResourceManager.
+        template<class R>
+        R &AddFromStream(const std::string &id, sf::InputStream &stream, CacheMode mode = CacheMode::Update);
+
+        /// Add resource to the ResourceManager from a deserializer function and tag it with this instance of ResourceScope.
+        /// \tparam R Type of Resource to load.
+        /// \param id Value to identify the resource.
+        /// \param deserializer Resource deserialization function which describe how resource get loaded.
+        /// \param mode Specifies store mode to use when the resource is stored.
+        /// \return Reference to the resource that managed by ResourceManager.
+        template<class R>
+        R &AddFromDeserializer(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode = CacheMode::Update);
+
+        /// Tag a resource that already stored inside the ResourceManager with this instance of ResourceScope.
+        /// \tparam R Type of Resource to tag.
+        /// \param id ID of Resource to tag.
+        /// \return true if resource is found; otherwise, false.
+        template<class R>
+        bool Adopt(const ResourceID &id);
+
+        /// Load the given resources as a single batch and tag them with this instance of ResourceScope.
+        ///
+        /// \remark
+        /// The files are prefetched, then loaded concurrently by the worker threads of the ResourceManager with CacheMode::Reuse.
+        /// This function blocks until every entry is completed. Resources that successfully loaded stay tagged even when
+        /// other entries fail, the first exception is rethrown once the batch is completed.
+        /// \param entries Resources to load, see CreateEntry.
+        void Preload(const std::vector<Entry> &entries);
+
+        /// Gets the number of resources that tagged with this instance of ResourceScope.
+        /// \return The number of tagged resources, including the ones that destroyed individually.
+        std::size_t Count() const;
+
+        /// Destroy the resources that tagged with this instance of ResourceScope.
+        /// The scope is empty afterward and can be used to add another group of resources.
+        /// \return The number of destroyed resources.
+        std::size_t Release();
+
+    private:
+        struct Record
+        {
+            std::uint32_t Type;
+            std::uint32_t Index;
+            std::uint32_t Generation;
+        };
+        using Block = std::unique_ptr<Record[]>;
+
+        static constexpr std::size_t BlockSize = 256;
+
+        template<class R>
+        static std::function<void()> Load(ResourceScope &scope, const Entry &entry);
+
+        template<class R>
+        R &Track(const ResourceID &id, R &resource);
+
+        void Track(std::size_t type, std::uint32_t index, std::uint32_t generation);
+
+        ResourceManager   &m_manager;
+        std::vector<Block> m_blocks;
+        std::size_t        m_count;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#include <Genode/IO/ResourceScope.inl>
+#endif //GENODE_RESOURCE_SCOPE_HPP
@@ -0,0 +1,66 @@
+#include <Genode/IO/ResourceManager.hpp>
+
+namespace Gx
+{
+    template<class R>
+    ResourceScope::Entry ResourceScope::CreateEntry(const std::string &id, const std::string &fileName)
+    {
+        return { id, fileName, &ResourceScope::Load<R> };
+    }
+
+    template<class R>
+    R &ResourceScope::AddFromFile(const std::string &id, const std::string &fileName, CacheMode mode)
+    {
+        return Track(id, m_manager.AddFromFile<R>(id, fileName, mode));
+    }
+
+    template<class R>
+    R &ResourceScope::AddFromMemory(const std::string &id, void *data, std::size_t size, CacheMode mode)
+    {
+        return Track(id, m_manager.AddFromMemory<R>(id, data, size, mode));
+    }
+
+    template<class R>
+    R &ResourceScope::AddFromStream(const std::string &id, sf::InputStream &stream, CacheMode mode)
+    {
+        return Track(id, m_manager.AddFromStream<R>(id, stream, mode));
+    }
+
+    template<class R>
+    R &ResourceScope::AddFromDeserializer(const std::string &id, std::function<std::unique_ptr<R>()> deserializer, CacheMode mode)
+    {
+        return Track(id, m_manager.AddFromDeserializer<R>(id, std::move(deserializer), mode));
+    }
+
+    template<class R>
+    bool ResourceScope::Adopt(const ResourceID &id)
+    {
+        auto handle = m_manager.Tag<R>(id);
+        if (!handle.IsValid())
+            return false;
+
+        Track(ResourceManager::GetTypeIndex<R>(), handle.Index, handle.Generation);
+        return true;
+    }
+
+    template<class R>
+    std::function<void()> ResourceScope::Load(ResourceScope &scope, const Entry &entry)
+    {
+        auto future = scope.m_manager.AddFromFileAsync<R>(entry.ID, entry.FileName, CacheMode::Reuse);
+        return [&scope, future, id = entry.ID] () {
+            scope.Track(id, future.Get());
+        };
+    }
+
+    template<class R>
+    R &ResourceScope::Track(const ResourceID &id, R &resource)
+    {
+        // The resource may be destroyed or replaced by another thread before it get tagged,
+        // in which case it is no longer stored and there's nothing to release
+        auto handle = m_manager.Tag<R>(id, &resource);
+        if (handle.IsValid())
+            Track(ResourceManager::GetTypeIndex<R>(), handle.Index, handle.Generation);
+
+        return resource;
+    }
+}
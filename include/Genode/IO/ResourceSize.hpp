@@ -0,0 +1,81 @@
+#ifndef GENODE_RESOURCE_SIZE_HPP
+#define GENODE_RESOURCE_SIZE_HPP
+
+#include <cstddef>
+
+namespace sf
+{
+    class Texture;
+    class SoundBuffer;
+    class Font;
+}
+
+namespace Gx
+{
+    class TextureAtlas;
+    class AudioStream;
+
+    /// Estimates the amount of memory held by a particular type of resource.
+    /// Specialize this template to provide more accurate estimation for custom resource types.
+    /// \tparam R Type of resource to estimate.
+    template<class R>
+    struct ResourceSize
+    {
+        /// Whether the estimation require the size of resource source (e.g. file size).
+        /// The size of source is passed as zero when this is false or the source is unknown.
+        static constexpr bool UseSourceSize = false;
+
+        /// Estimate the amount of memory held by given \p resource.
+        /// \param resource Resource to estimate.
+        /// \param sourceSize Size of the source that the resource loaded from, in bytes.
+        /// \return Estimated size of resource, in bytes.
+        static std::size_t Get(const R &resource, std::size_t sourceSize)
+        {
+            (void)resource;
+            (void)sourceSize;
+            return sizeof(R);
+        }
+    };
+
+    /// Estimates the texture as 32-bit pixels including the mipmap chain.
+    template<>
+    struct ResourceSize<sf::Texture>
+    {
+        static constexpr bool UseSourceSize = false;
+        static std::size_t Get(const sf::Texture &resource, std::size_t sourceSize);
+    };
+
+    /// Estimates the texture atlas as 32-bit pixels of all of its textures.
+    template<>
+    struct ResourceSize<TextureAtlas>
+    {
+        static constexpr bool UseSourceSize = false;
+        static std::size_t Get(const TextureAtlas &resource, std::size_t sourceSize);
+    };
+
+    /// Estimates the sound buffer as 16-bit samples.
+    template<>
+    struct ResourceSize<sf::SoundBuffer>
+    {
+        static constexpr bool UseSourceSize = false;
+        static std::size_t Get(const sf::SoundBuffer &resource, std::size_t sourceSize);
+    };
+
+    /// Estimates the audio stream by its buffered source and decoded chunks, the rest of the audio stays compressed.
+    template<>
+    struct ResourceSize<AudioStream>
+    {
+        static constexpr bool UseSourceSize = false;
+        static std::size_t Get(const AudioStream &resource, std::size_t sourceSize);
+    };
+
+    /// Estimates the font by the size of its source, font face is kept alongside the font.
+    template<>
+    struct ResourceSize<sf::Font>
+    {
+        static constexpr bool UseSourceSize = true;
+        static std::size_t Get(const sf::Font &resource, std::size_t sourceSize);
+    };
+}
+
+#endif //GENODE_RESOURCE_SIZE_HPP
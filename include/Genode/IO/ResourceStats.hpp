@@ -0,0 +1,56 @@
+#ifndef GENODE_RESOURCE_STATS_HPP
+#define GENODE_RESOURCE_STATS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Gx
+{
+    /// Represents the estimated memory usage of a single resource.
+    struct ResourceUsage
+    {
+        /// ID of the resource.
+        std::string ID;
+
+        /// Estimated size of the resource, in bytes.
+        std::size_t Bytes = 0;
+    };
+
+    /// Represents the memory usage of a particular type of resources.
+    struct ResourceTypeStats
+    {
+        /// Implementation defined name of the resource type.
+        std::string Type;
+
+        /// The number of resources, including evicted resources.
+        std::size_t Count         = 0;
+
+        /// The number of resources that currently held in memory.
+        std::size_t ResidentCount = 0;
+
+        /// Estimated size of resources that currently held in memory, in bytes.
+        std::size_t Bytes         = 0;
+
+        /// The highest estimated size of resources that ever held in memory at once, in bytes.
+        std::size_t PeakBytes     = 0;
+
+        /// The largest resources that currently held in memory, ordered from the largest.
+        std::vector<ResourceUsage> Largest;
+    };
+
+    /// Represents a snapshot of the memory usage of resources inside a ResourceManager.
+    struct ResourceStats
+    {
+        /// Memory usage of each type of resources.
+        std::vector<ResourceTypeStats> Types;
+
+        /// Estimated size of all resources that currently held in memory, in bytes.
+        std::size_t Bytes     = 0;
+
+        /// The highest estimated size of all resources that ever held in memory at once, in bytes.
+        std::size_t PeakBytes = 0;
+    };
+}
+
+#endif //GENODE_RESOURCE_STATS_HPP
@@ -0,0 +1,55 @@
+#ifndef GENODE_SKYLINE_PACKER_HPP
+#define GENODE_SKYLINE_PACKER_HPP
+
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+namespace Gx
+{
+    /// Packs rectangles into a fixed-size area by using the bottom-left skyline heuristic.
+    ///
+    /// \remark
+    /// The skyline tracks the top edge of the packed rectangles, each rectangle is placed at the lowest position
+    /// it fits, preferring the leftmost one. Packing rectangles sorted by descending height yield the tightest result.
+    class SkylinePacker
+    {
+    public:
+        /// Initializes a new instance of SkylinePacker.
+        /// \param width Width of the area to pack into.
+        /// \param height Height of the area to pack into.
+        SkylinePacker(unsigned width, unsigned height);
+
+        /// Find a position for a rectangle of given size and reserve it.
+        /// \param width Width of the rectangle.
+        /// \param height Height of the rectangle.
+        /// \param position Receive the top-left position of the rectangle.
+        /// \return true if the rectangle is packed; otherwise, false if there's no room left for it.
+        bool Insert(unsigned width, unsigned height, sf::Vector2u &position);
+
+        /// Gets the size of area to pack into.
+        /// \return The size of area to pack into.
+        sf::Vector2u GetSize() const;
+
+        /// Gets the height of area that occupied by packed rectangles.
+        /// \return The height of area that occupied by packed rectangles.
+        unsigned GetUsedHeight() const;
+
+    private:
+        struct Segment
+        {
+            unsigned X;
+            unsigned Y;
+            unsigned Width;
+        };
+
+        bool Fit(std::size_t index, unsigned width, unsigned height, unsigned &y) const;
+
+        std::vector<Segment> m_skyline;
+        unsigned             m_width;
+        unsigned             m_height;
+        unsigned             m_usedHeight;
+    };
+}
+
+#endif //GENODE_SKYLINE_PACKER_HPP
@@ -0,0 +1,86 @@
+#ifndef GENODE_TEXTURE_ATLAS_HPP
+#define GENODE_TEXTURE_ATLAS_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+namespace sf
+{
+    class Texture;
+}
+
+namespace Gx
+{
+    /// Represents a set of images that packed into one or few textures, each image is identified by its name.
+    ///
+    /// \remark
+    /// TextureAtlas is stored and destroyed as a single resource, use FindRegion to locate the images inside the atlas:
+    /// \code
+    /// auto atlas  = resources.Find<Gx::TextureAtlas>("ui");
+    /// auto region = atlas->FindRegion("icons/close.png");
+    /// sprite.setTexture(atlas->GetTexture(region->Page));
+    /// sprite.setTextureRect(region->Rect);
+    /// \endcode
+    class TextureAtlas
+    {
+    public:
+        /// Represents the location of an image inside TextureAtlas.
+        struct Region
+        {
+            /// Index of the texture that contains the image.
+            std::size_t Page = 0;
+
+            /// Area of the image inside the texture.
+            sf::IntRect Rect;
+        };
+
+        /// Initializes an empty instance of TextureAtlas.
+        TextureAtlas();
+
+        /// Releases the textures of TextureAtlas.
+        ~TextureAtlas();
+
+        /// Add a texture into this instance of TextureAtlas.
+        /// \param texture Texture to add.
+        /// \return Index of the added texture.
+        std::size_t AddTexture(std::unique_ptr<sf::Texture> texture);
+
+        /// Add a named region into this instance of TextureAtlas, region with the same name is replaced.
+        /// \param name Name of the image.
+        /// \param region Location of the image.
+        void AddRegion(const std::string &name, const Region &region);
+
+        /// Find the region of the image with given \p name.
+        /// \param name Name of the image.
+        /// \return Pointer of Region if exists; otherwise, nullptr.
+        const Region *FindRegion(const std::string &name) const;
+
+        /// Gets the texture at given \p page.
+        /// \param page Index of the texture.
+        /// \return Texture at given page.
+        sf::Texture &GetTexture(std::size_t page);
+
+        /// Gets the texture at given \p page.
+        /// \param page Index of the texture.
+        /// \return Texture at given page.
+        const sf::Texture &GetTexture(std::size_t page) const;
+
+        /// Gets the number of textures inside this instance of TextureAtlas.
+        /// \return The number of textures.
+        std::size_t GetPageCount() const;
+
+        /// Gets the number of regions inside this instance of TextureAtlas.
+        /// \return The number of regions.
+        std::size_t GetRegionCount() const;
+
+    private:
+        std::vector<std::unique_ptr<sf::Texture>> m_pages;
+        std::unordered_map<std::string, Region>   m_regions;
+    };
+}
+
+#endif //GENODE_TEXTURE_ATLAS_HPP
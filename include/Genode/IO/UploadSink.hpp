@@ -0,0 +1,38 @@
+#ifndef GENODE_UPLOAD_SINK_HPP
+#define GENODE_UPLOAD_SINK_HPP
+
+namespace sf
+{
+    class Image;
+    class Texture;
+}
+
+namespace Gx
+{
+    /// Represents an interface that transfer decoded resources into the graphics device.
+    ///
+    /// \remark
+    /// Uploads are only performed by ResourceManager::PumpUploads, on the thread that owns the graphics context.
+    /// Replace the default sink to run the pipeline without a graphics context, e.g. in tests or on a headless server.
+    class IUploadSink
+    {
+    public:
+        virtual ~IUploadSink() = default;
+
+        /// Upload given \p image into given \p texture.
+        /// \param texture Texture to upload the image into.
+        /// \param image Decoded image to upload.
+        /// \param smooth Whether the smooth filter should be enabled for the texture.
+        /// \return true if the upload is succeeded; otherwise, false.
+        virtual bool Upload(sf::Texture &texture, const sf::Image &image, bool smooth) = 0;
+    };
+
+    /// Uploads the textures into OpenGL by using sf::Texture::loadFromImage.
+    class TextureUploadSink : public IUploadSink
+    {
+    public:
+        bool Upload(sf::Texture &texture, const sf::Image &image, bool smooth) override;
+    };
+}
+
+#endif //GENODE_UPLOAD_SINK_HPP
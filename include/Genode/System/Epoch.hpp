@@ -0,0 +1,61 @@
+#ifndef GENODE_EPOCH_HPP
+#define GENODE_EPOCH_HPP
+
+#include <cstddef>
+
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Provides epoch-based reclamation for data structures that are read without lock.
+    ///
+    /// \remark
+    /// Readers enter the epoch with EpochGuard before loading shared pointers and leave it once they no longer use them.
+    /// Writers unlink the objects first, then Retire them; retired objects are only destroyed once every reader
+    /// that might still observe them has left its epoch.
+    /// Entering is reentrant and costs a single store for the outermost guard of a thread.
+    class Epoch final
+    {
+    public:
+        using Deleter = void (*)(void *);
+
+        /// Enter the epoch on the calling thread, objects retired afterwards are kept alive until Leave is called.
+        static void Enter();
+
+        /// Leave the epoch on the calling thread.
+        static void Leave();
+
+        /// Destroy given \p object with \p deleter once no reader can observe it anymore.
+        /// The object must be unreachable for new readers before it get retired.
+        /// \param object Object to retire.
+        /// \param deleter Function to destroy the object.
+        static void Retire(void *object, Deleter deleter);
+
+        /// Retire given \p object that allocated with new.
+        /// \tparam T Type of object to retire.
+        /// \param object Object to retire.
+        template<class T>
+        static void Retire(T *object)
+        {
+            Retire(const_cast<void*>(static_cast<const void*>(object)), [] (void *ptr) { delete static_cast<T*>(ptr); });
+        }
+
+        /// Advance the epoch if possible and destroy the retired objects that no reader can observe anymore.
+        /// This is called periodically by Retire, call it explicitly to release memory sooner.
+        static void Collect();
+
+        /// Gets the number of retired objects that are waiting to be destroyed.
+        /// \return The number of pending retired objects.
+        static std::size_t GetPendingCount();
+    };
+
+    /// Keeps the calling thread inside the epoch during the lifetime of the guard.
+    class EpochGuard final : private NonCopyable
+    {
+    public:
+        EpochGuard()  { Epoch::Enter(); }
+        ~EpochGuard() { Epoch::Leave(); }
+    };
+}
+
+#endif //GENODE_EPOCH_HPP
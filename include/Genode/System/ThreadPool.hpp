@@ -0,0 +1,55 @@
+#ifndef GENODE_THREAD_POOL_HPP
+#define GENODE_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <Genode/System/NonCopyable.hpp>
+
+namespace Gx
+{
+    /// Represents a fixed-size pool of worker threads that execute queued tasks in FIFO order.
+    class ThreadPool final : private NonCopyable
+    {
+    public:
+        /// Initializes a new instance of ThreadPool.
+        /// \param workerCount The number of worker threads, 0 to use the number of hardware threads.
+        explicit ThreadPool(std::size_t workerCount = 0);
+
+        /// Finishes every queued task and joins the worker threads.
+        ~ThreadPool();
+
+        /// Queue a task to be executed by one of the worker threads.
+        /// The task must handle its own exceptions.
+        /// \param task The task to execute.
+        void Enqueue(std::function<void()> task);
+
+        /// Block the calling thread until every queued and running task is finished.
+        void Wait();
+
+        /// Gets the number of worker threads of this instance of ThreadPool.
+        /// \return The number of worker threads.
+        std::size_t GetWorkerCount() const;
+
+        /// Gets a value indicating whether the calling thread is one of the worker threads of this instance of ThreadPool.
+        /// \return true if the calling thread is a worker thread; otherwise, false.
+        bool IsWorkerThread() const;
+
+    private:
+        void Run();
+
+        std::vector<std::thread>          m_workers;
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex                        m_mutex;
+        std::condition_variable           m_available;
+        std::condition_variable           m_idle;
+        std::size_t                       m_running;
+        bool                              m_stopping;
+    };
+}
+
+#endif //GENODE_THREAD_POOL_HPP
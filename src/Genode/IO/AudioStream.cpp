@@ -0,0 +1,78 @@
+#include <Genode/IO/AudioStream.hpp>
+
+#include <Genode/IO/FileSystem.hpp>
+
+namespace Gx
+{
+    AudioStream::AudioStream() = default;
+
+    AudioStream::~AudioStream()
+    {
+        // The streaming thread of sf::Music is joined by its own destructor, which runs after the source is released
+        stop();
+    }
+
+    bool AudioStream::OpenFromFile(const std::string &fileName)
+    {
+        auto fullName = Gx::FileSystem::GetFullName(fileName);
+        if (!fullName.empty())
+        {
+            Close();
+            return openFromFile(fullName);
+        }
+
+        // File is not located in the disk (e.g. packed archive), stream it from mounted FileSystem instead
+        auto stream = Gx::FileSystem::Open(fileName);
+        if (!stream)
+            return false;
+
+        return OpenFromStream(std::move(stream));
+    }
+
+    bool AudioStream::OpenFromMemory(const void *data, std::size_t size)
+    {
+        auto bytes = static_cast<const char*>(data);
+        return OpenFromMemory(std::vector<char>(bytes, bytes + size));
+    }
+
+    bool AudioStream::OpenFromMemory(std::vector<char> data)
+    {
+        Close();
+        m_data = std::move(data);
+
+        return openFromMemory(m_data.data(), m_data.size());
+    }
+
+    bool AudioStream::OpenFromStream(std::unique_ptr<sf::InputStream> stream)
+    {
+        if (!stream)
+            return false;
+
+        Close();
+        m_stream = std::move(stream);
+
+        return openFromStream(*m_stream);
+    }
+
+    std::size_t AudioStream::GetSourceSize() const
+    {
+        return m_data.size();
+    }
+
+    std::size_t AudioStream::GetBufferSize() const
+    {
+        // sf::Music decodes one second of samples per chunk and keeps up to 3 chunks queued in the audio device
+        auto chunk = static_cast<std::size_t>(getSampleRate()) * getChannelCount() * sizeof(sf::Int16);
+        return chunk * 4;
+    }
+
+    void AudioStream::Close()
+    {
+        // Playback must be stopped before the source is released, the streaming thread may still be reading it
+        stop();
+
+        m_stream.reset();
+        m_data.clear();
+        m_data.shrink_to_fit();
+    }
+}
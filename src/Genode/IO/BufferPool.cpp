@@ -0,0 +1,156 @@
+#include <Genode/IO/BufferPool.hpp>
+
+#include <new>
+#include <utility>
+
+namespace Gx
+{
+    BufferPool::Buffer::Buffer(BufferPool *pool, unsigned char *data, std::size_t size, std::size_t capacity) :
+        m_pool(pool),
+        m_data(data),
+        m_size(size),
+        m_capacity(capacity),
+        m_valid(true)
+    {
+    }
+
+    BufferPool::Buffer::Buffer(Buffer &&other) noexcept :
+        m_pool(std::exchange(other.m_pool, nullptr)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_valid(std::exchange(other.m_valid, false))
+    {
+    }
+
+    BufferPool::Buffer &BufferPool::Buffer::operator=(Buffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+
+            m_pool     = std::exchange(other.m_pool, nullptr);
+            m_data     = std::exchange(other.m_data, nullptr);
+            m_size     = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_valid    = std::exchange(other.m_valid, false);
+        }
+
+        return *this;
+    }
+
+    BufferPool::Buffer::~Buffer()
+    {
+        Release();
+    }
+
+    void BufferPool::Buffer::Shrink(std::size_t size)
+    {
+        if (size < m_size)
+            m_size = size;
+    }
+
+    void BufferPool::Buffer::Release()
+    {
+        if (m_data)
+            m_pool->Recycle(m_data, m_capacity);
+
+        m_pool     = nullptr;
+        m_data     = nullptr;
+        m_size     = 0;
+        m_capacity = 0;
+        m_valid    = false;
+    }
+
+    BufferPool::BufferPool(std::size_t retention) :
+        m_retained(0),
+        m_retention(retention)
+    {
+    }
+
+    BufferPool::~BufferPool()
+    {
+        Trim();
+    }
+
+    BufferPool &BufferPool::GetDefault()
+    {
+        static BufferPool pool;
+        return pool;
+    }
+
+    BufferPool::Buffer BufferPool::Acquire(std::size_t size)
+    {
+        if (size == 0)
+            return Buffer(this, nullptr, 0, 0);
+
+        if (size > MaxPooledSize)
+            return Buffer(this, static_cast<unsigned char*>(::operator new(size)), size, size);
+
+        auto index    = GetClassIndex(size);
+        auto capacity = MinPooledSize << index;
+        auto &target  = m_classes[index];
+        {
+            std::lock_guard<std::mutex> lock(target.Mutex);
+            if (!target.Blocks.empty())
+            {
+                auto data = target.Blocks.back();
+                target.Blocks.pop_back();
+                m_retained.fetch_sub(capacity, std::memory_order_relaxed);
+
+                return Buffer(this, data, size, capacity);
+            }
+        }
+
+        return Buffer(this, static_cast<unsigned char*>(::operator new(capacity)), size, capacity);
+    }
+
+    std::size_t BufferPool::GetRetainedSize() const
+    {
+        return m_retained.load(std::memory_order_relaxed);
+    }
+
+    void BufferPool::Trim()
+    {
+        for (std::size_t index = 0; index < m_classes.size(); index++)
+        {
+            // Only the freed blocks are subtracted, concurrent Recycle may keep adding blocks into the classes
+            auto &sizeClass = m_classes[index];
+            std::vector<unsigned char*> blocks;
+            {
+                std::lock_guard<std::mutex> lock(sizeClass.Mutex);
+                blocks.swap(sizeClass.Blocks);
+                m_retained.fetch_sub(blocks.size() * (MinPooledSize << index), std::memory_order_relaxed);
+            }
+
+            for (auto block : blocks)
+                ::operator delete(block);
+        }
+    }
+
+    std::size_t BufferPool::GetClassIndex(std::size_t size)
+    {
+        std::size_t index = 0;
+        while ((MinPooledSize << index) < size)
+            index++;
+
+        return index;
+    }
+
+    void BufferPool::Recycle(unsigned char *data, std::size_t capacity)
+    {
+        // Oversized buffers and buffers beyond the retention are freed right away
+        if (capacity > MaxPooledSize || m_retained.fetch_add(capacity, std::memory_order_relaxed) + capacity > m_retention)
+        {
+            if (capacity <= MaxPooledSize)
+                m_retained.fetch_sub(capacity, std::memory_order_relaxed);
+
+            ::operator delete(data);
+            return;
+        }
+
+        auto &target = m_classes[GetClassIndex(capacity)];
+        std::lock_guard<std::mutex> lock(target.Mutex);
+        target.Blocks.push_back(data);
+    }
+}
@@ -0,0 +1,324 @@
+#include <Genode/IO/DecodeCache.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Gx
+{
+    namespace
+    {
+        constexpr char          Magic[8] = { 'G', 'X', 'D', 'C', 'A', 'C', 'H', 'E' };
+        constexpr std::uint32_t Version  = 1;
+
+        // Entries are written by the machine that read them, the header is stored in the native byte order
+        struct FileHeader
+        {
+            char          Magic[8];
+            std::uint32_t Version;
+            std::uint32_t Format;
+            std::uint64_t Hash;
+            std::uint64_t SourceSize;
+            std::uint64_t DataSize;
+            std::uint32_t Width;
+            std::uint32_t Height;
+            std::uint32_t ChannelCount;
+            std::uint32_t SampleRate;
+        };
+
+        constexpr std::uint64_t Prime1 = 11400714785074694791ull;
+        constexpr std::uint64_t Prime2 = 14029467366897019727ull;
+        constexpr std::uint64_t Prime3 = 1609587929392839161ull;
+        constexpr std::uint64_t Prime4 = 9650029242287828579ull;
+        constexpr std::uint64_t Prime5 = 2870177450012600261ull;
+
+        std::uint64_t RotateLeft(std::uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        std::uint64_t Read64(const unsigned char *data)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t Read32(const unsigned char *data)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        std::uint64_t Round(std::uint64_t accumulator, std::uint64_t input)
+        {
+            accumulator += input * Prime2;
+            return RotateLeft(accumulator, 31) * Prime1;
+        }
+
+        std::uint64_t Merge(std::uint64_t accumulator, std::uint64_t value)
+        {
+            accumulator ^= Round(0, value);
+            return accumulator * Prime1 + Prime4;
+        }
+    }
+
+    bool DecodeCache::Enable(const std::string &directory, std::size_t capacity)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error || !std::filesystem::is_directory(directory, error))
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directory = directory;
+        m_capacity  = capacity;
+        TrimLocked();
+        m_enabled.store(true, std::memory_order_release);
+
+        return true;
+    }
+
+    void DecodeCache::Disable()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled.store(false, std::memory_order_release);
+        m_directory.clear();
+        m_capacity = 0;
+        m_size     = 0;
+    }
+
+    bool DecodeCache::IsEnabled()
+    {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    std::size_t DecodeCache::GetSize()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_size;
+    }
+
+    std::uint64_t DecodeCache::Hash(const void *data, std::size_t size)
+    {
+        // XXH64, hashing a source must stay well below the cost of decoding it
+        auto bytes = static_cast<const unsigned char*>(data);
+        auto end   = bytes + size;
+
+        std::uint64_t hash;
+        if (size >= 32)
+        {
+            std::uint64_t v1 = Prime1 + Prime2;
+            std::uint64_t v2 = Prime2;
+            std::uint64_t v3 = 0;
+            std::uint64_t v4 = 0 - Prime1;
+            for (; bytes + 32 <= end; bytes += 32)
+            {
+                v1 = Round(v1, Read64(bytes));
+                v2 = Round(v2, Read64(bytes + 8));
+                v3 = Round(v3, Read64(bytes + 16));
+                v4 = Round(v4, Read64(bytes + 24));
+            }
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = Merge(hash, v1);
+            hash = Merge(hash, v2);
+            hash = Merge(hash, v3);
+            hash = Merge(hash, v4);
+        }
+        else
+            hash = Prime5;
+
+        hash += static_cast<std::uint64_t>(size);
+        for (; bytes + 8 <= end; bytes += 8)
+            hash = RotateLeft(hash ^ Round(0, Read64(bytes)), 27) * Prime1 + Prime4;
+
+        if (bytes + 4 <= end)
+        {
+            hash  = RotateLeft(hash ^ (static_cast<std::uint64_t>(Read32(bytes)) * Prime1), 23) * Prime2 + Prime3;
+            bytes += 4;
+        }
+
+        for (; bytes < end; bytes++)
+            hash = RotateLeft(hash ^ (*bytes * Prime5), 11) * Prime1;
+
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+
+    DecodeCache::Key DecodeCache::CreateKey(Format format, const void *data, std::size_t size)
+    {
+        return Key{ format, Hash(data, size), size };
+    }
+
+    std::unique_ptr<DecodeCache::Entry> DecodeCache::Find(const Key &key)
+    {
+        if (!IsEnabled())
+            return nullptr;
+
+        std::string fileName;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_directory.empty())
+                return nullptr;
+
+            fileName = GetEntryName(m_directory, key);
+        }
+
+        auto entry = std::unique_ptr<Entry>(new Entry());
+        if (!entry->m_file.Open(fileName))
+            return nullptr;
+
+        // Entries that written by other version or truncated by a crash are treated as a miss and replaced on the next store
+        FileHeader header{};
+        if (entry->m_file.GetSize() >= HeaderSize)
+            std::memcpy(&header, entry->m_file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0 || header.Version != Version ||
+            header.Format != static_cast<std::uint32_t>(key.Kind) || header.Hash != key.Hash || header.SourceSize != key.SourceSize ||
+            header.DataSize != entry->m_file.GetSize() - HeaderSize)
+            return nullptr;
+
+        entry->m_properties = Properties{ header.Width, header.Height, header.ChannelCount, header.SampleRate };
+
+        // The modification time of entries track their last use
+        std::error_code error;
+        std::filesystem::last_write_time(fileName, std::filesystem::file_time_type::clock::now(), error);
+
+        return entry;
+    }
+
+    bool DecodeCache::Store(const Key &key, const Properties &properties, const void *data, std::size_t size)
+    {
+        if (!IsEnabled())
+            return false;
+
+        std::string fileName;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_directory.empty() || size > m_capacity / 4)
+                return false;
+
+            fileName = GetEntryName(m_directory, key);
+        }
+
+        FileHeader header{};
+        std::memcpy(header.Magic, Magic, sizeof(Magic));
+        header.Version      = Version;
+        header.Format       = static_cast<std::uint32_t>(key.Kind);
+        header.Hash         = key.Hash;
+        header.SourceSize   = key.SourceSize;
+        header.DataSize     = size;
+        header.Width        = properties.Width;
+        header.Height       = properties.Height;
+        header.ChannelCount = properties.ChannelCount;
+        header.SampleRate   = properties.SampleRate;
+
+        char padding[HeaderSize] = {};
+        static_assert(sizeof(FileHeader) <= HeaderSize, "DecodeCache header must fit within the reserved space");
+        std::memcpy(padding, &header, sizeof(header));
+
+        // Write to a temporary file first, readers of the same key either see the old entry or the complete new one
+        auto temporary = fileName + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        {
+            auto output = std::ofstream(temporary, std::ios::binary | std::ios::trunc);
+            output.write(padding, HeaderSize);
+            output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!output)
+            {
+                output.close();
+                std::remove(temporary.c_str());
+                return false;
+            }
+        }
+
+        std::error_code error;
+        auto previous = std::filesystem::file_size(fileName, error);
+        if (error)
+            previous = 0;
+
+        std::filesystem::rename(temporary, fileName, error);
+        if (error)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_size = m_size - std::min<std::size_t>(m_size, previous) + HeaderSize + size;
+        if (m_size > m_capacity)
+            TrimLocked();
+
+        return true;
+    }
+
+    void DecodeCache::Trim()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_directory.empty())
+            TrimLocked();
+    }
+
+    std::string DecodeCache::GetEntryName(const std::string &directory, const Key &key)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%u-%016llx.bin", static_cast<unsigned>(key.Kind), static_cast<unsigned long long>(key.Hash));
+
+        return (std::filesystem::path(directory) / name).string();
+    }
+
+    void DecodeCache::TrimLocked()
+    {
+        struct Candidate
+        {
+            std::filesystem::path           Path;
+            std::uintmax_t                  Size;
+            std::filesystem::file_time_type LastUse;
+        };
+
+        // The directory is rescanned rather than tracked, entries may be added or removed by other processes
+        std::vector<Candidate> candidates;
+        std::error_code        error;
+        m_size = 0;
+        for (auto &file : std::filesystem::directory_iterator(m_directory, error))
+        {
+            if (!file.is_regular_file(error) || file.path().extension() != ".bin")
+                continue;
+
+            auto size    = file.file_size(error);
+            auto lastUse = file.last_write_time(error);
+            if (error)
+                continue;
+
+            m_size += static_cast<std::size_t>(size);
+            candidates.push_back(Candidate{ file.path(), size, lastUse });
+        }
+
+        if (m_size <= m_capacity)
+            return;
+
+        std::sort(candidates.begin(), candidates.end(), [] (const Candidate &a, const Candidate &b) {
+            return a.LastUse < b.LastUse;
+        });
+
+        for (auto &candidate : candidates)
+        {
+            if (m_size <= m_capacity)
+                break;
+
+            if (std::filesystem::remove(candidate.Path, error))
+                m_size -= std::min<std::size_t>(m_size, static_cast<std::size_t>(candidate.Size));
+        }
+    }
+}
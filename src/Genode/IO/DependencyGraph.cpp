@@ -0,0 +1,166 @@
+#include <Genode/IO/DependencyGraph.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    // Fields are separated by tabs, which are not expected inside type names, IDs and file names
+    std::vector<std::string> Split(const std::string &line)
+    {
+        std::vector<std::string> fields;
+        std::size_t start = 0, end;
+        while ((end = line.find('\t', start)) != std::string::npos)
+        {
+            fields.push_back(line.substr(start, end - start));
+            start = end + 1;
+        }
+
+        fields.push_back(line.substr(start));
+        return fields;
+    }
+
+    bool ParseIndex(const std::string &value, std::size_t count, std::size_t &index)
+    {
+        std::istringstream stream(value);
+        return (stream >> index) && stream.eof() && index < count;
+    }
+}
+
+namespace Gx
+{
+    std::size_t DependencyGraph::Insert(const std::string &type, const std::string &id)
+    {
+        auto result = m_index.emplace(Key(type, id), m_nodes.size());
+        if (result.second)
+        {
+            m_nodes.emplace_back();
+            m_nodes.back().Type = type;
+            m_nodes.back().ID   = id;
+        }
+
+        return result.first->second;
+    }
+
+    std::size_t DependencyGraph::Find(const std::string &type, const std::string &id) const
+    {
+        auto it = m_index.find(Key(type, id));
+        return it != m_index.end() ? it->second : NoNode;
+    }
+
+    bool DependencyGraph::Connect(std::size_t dependent, std::size_t dependency)
+    {
+        auto &dependencies = m_nodes[dependent].Dependencies;
+        if (dependent == dependency || std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end())
+            return false;
+
+        dependencies.push_back(dependency);
+        m_nodes[dependency].Dependents.push_back(dependent);
+
+        return true;
+    }
+
+    DependencyGraph::Node &DependencyGraph::GetNode(std::size_t index)
+    {
+        return m_nodes[index];
+    }
+
+    const DependencyGraph::Node &DependencyGraph::GetNode(std::size_t index) const
+    {
+        return m_nodes[index];
+    }
+
+    std::size_t DependencyGraph::GetNodeCount() const
+    {
+        return m_nodes.size();
+    }
+
+    std::vector<std::size_t> DependencyGraph::Sort() const
+    {
+        // Nodes are emitted once all of their dependencies are emitted, nodes on a cycle never get there
+        std::vector<std::size_t> order, pending(m_nodes.size());
+        order.reserve(m_nodes.size());
+        for (std::size_t i = 0; i < m_nodes.size(); i++)
+        {
+            pending[i] = m_nodes[i].Dependencies.size();
+            if (pending[i] == 0)
+                order.push_back(i);
+        }
+
+        for (std::size_t i = 0; i < order.size(); i++)
+        {
+            for (auto dependent : m_nodes[order[i]].Dependents)
+            {
+                if (--pending[dependent] == 0)
+                    order.push_back(dependent);
+            }
+        }
+
+        return order;
+    }
+
+    bool DependencyGraph::Save(const std::string &fileName) const
+    {
+        std::ofstream file(fileName, std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << "# Genode dependency manifest\n";
+        for (auto &node : m_nodes)
+            file << "N\t" << node.Type << '\t' << node.ID << '\t' << node.FileName << '\n';
+
+        for (std::size_t i = 0; i < m_nodes.size(); i++)
+        {
+            for (auto dependency : m_nodes[i].Dependencies)
+                file << "D\t" << i << '\t' << dependency << '\n';
+        }
+
+        return static_cast<bool>(file.flush());
+    }
+
+    bool DependencyGraph::Load(const std::string &fileName)
+    {
+        std::ifstream file(fileName);
+        if (!file)
+            return false;
+
+        // Node indices of the manifest are mapped into the current graph
+        std::vector<std::size_t> nodes;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            auto fields = Split(line);
+            if (fields[0] == "N" && fields.size() == 4)
+            {
+                auto index = Insert(fields[1], fields[2]);
+                if (!fields[3].empty())
+                    m_nodes[index].FileName = fields[3];
+
+                nodes.push_back(index);
+            }
+            else if (fields[0] == "D" && fields.size() == 3)
+            {
+                std::size_t dependent, dependency;
+                if (ParseIndex(fields[1], nodes.size(), dependent) && ParseIndex(fields[2], nodes.size(), dependency))
+                    Connect(nodes[dependent], nodes[dependency]);
+            }
+        }
+
+        return true;
+    }
+
+    void DependencyGraph::Clear()
+    {
+        m_nodes.clear();
+        m_index.clear();
+    }
+
+    std::size_t DependencyGraph::KeyHash::operator()(const Key &key) const
+    {
+        return std::hash<std::string>()(key.second) ^ (std::hash<std::string>()(key.first) * 0x9E3779B97F4A7C15ull);
+    }
+}
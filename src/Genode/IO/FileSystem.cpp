@@ -1,25 +1,45 @@
 #include <Genode/IO/FileSystem.hpp>
 #include <Genode/IO/FileSystems/LocalFileSystem.hpp>
+#include <Genode/IO/Instrumentation.hpp>
+#include <Genode/System/ThreadPool.hpp>
+
+#include <algorithm>
+#include <mutex>
 
 namespace Gx
 {
+    BufferPool::Buffer IFileSystem::ReadAll(const std::string &fileName, BufferPool &pool)
+    {
+        auto size = GetFileSize(fileName);
+        if (size == static_cast<std::size_t>(-1))
+            return {};
+
+        auto buffer = pool.Acquire(size);
+        if (size > 0 && Read(fileName, buffer.GetData(), size) != size)
+            return {};
+
+        return buffer;
+    }
+
     void FileSystem::EnsureDefaultFileSystemRegistered()
     {
-        static bool registered = false;
-        if (!registered)
-        {
-            Mount<Gx::LocalFileSystem>();
-            registered = true;
-        }
+        // Function-local static initialization is thread-safe, FileSystem may be accessed from worker threads
+        static const bool registered = [] {
+            Insert(std::make_unique<Gx::LocalFileSystem>(), 0);
+            return true;
+        }();
+        (void)registered;
     }
 
     std::vector<IFileSystem*> FileSystem::GetFileSystems()
     {
         EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
 
-        auto systems = std::vector<IFileSystem*>(m_systems.size());
-        for (auto &fs : m_systems)
-            systems.push_back(fs.get());
+        auto systems = std::vector<IFileSystem*>();
+        systems.reserve(m_systems.size());
+        for (auto &mount : m_systems)
+            systems.push_back(mount.System.get());
 
         return systems;
     }
@@ -27,55 +47,175 @@ namespace Gx
     bool FileSystem::IsExists(const std::string &fileName)
     {
         EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
 
-        return std::any_of(m_systems.begin(), m_systems.end(), [&] (auto &fs) { return fs->IsExists(fileName); });
+        return Resolve(fileName) != nullptr;
     }
 
     std::unique_ptr<sf::InputStream> FileSystem::Open(const std::string &fileName)
     {
-        for (auto &fs : m_systems)
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto start = Instrumentation::Start();
+        if (auto fs = Resolve(fileName))
         {
-            if (fs->IsExists(fileName))
-                return fs->Open(fileName);
+            auto stream = fs->Open(fileName);
+            Instrumentation::RecordFileAccess(FileOperation::Open, fileName, 0, start);
+
+            return stream;
         }
 
         return nullptr;
     }
 
+    MappedView FileSystem::Map(const std::string &fileName)
+    {
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto start = Instrumentation::Start();
+        if (auto fs = Resolve(fileName))
+        {
+            auto view = fs->Map(fileName);
+            Instrumentation::RecordFileAccess(FileOperation::Open, fileName, 0, start);
+
+            return view;
+        }
+
+        return {};
+    }
+
     std::size_t FileSystem::Read(const std::string &fileName, void *data, std::size_t size)
     {
-        for (auto &fs : m_systems)
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto start = Instrumentation::Start();
+        if (auto fs = Resolve(fileName))
         {
-            if (fs->IsExists(fileName))
-                return fs->Read(fileName, data, size);
+            auto bytes = fs->Read(fileName, data, size);
+            Instrumentation::RecordFileAccess(FileOperation::Read, fileName, bytes == static_cast<std::size_t>(-1) ? 0 : bytes, start);
+
+            return bytes;
         }
 
         return -1;
     }
 
-    std::size_t FileSystem::GetFileSize(const std::string &fileName)
+    BufferPool::Buffer FileSystem::ReadAll(const std::string &fileName, BufferPool &pool)
     {
-        for (auto &fs : m_systems)
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        auto start = Instrumentation::Start();
+        if (auto fs = Resolve(fileName))
         {
-            if (fs->IsExists(fileName))
-                return fs->GetFileSize(fileName);
+            auto buffer = fs->ReadAll(fileName, pool);
+            Instrumentation::RecordFileAccess(FileOperation::Read, fileName, buffer.GetSize(), start);
+
+            return buffer;
         }
 
+        return {};
+    }
+
+    std::size_t FileSystem::GetFileSize(const std::string &fileName)
+    {
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        if (auto fs = Resolve(fileName))
+            return fs->GetFileSize(fileName);
+
         return -1;
     }
 
     std::string FileSystem::GetFullName(const std::string &fileName)
     {
-        for (auto &fs : m_systems)
+        EnsureDefaultFileSystemRegistered();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        // Only the FileSystem that owns the file can resolve its full name
+        if (auto fs = Resolve(fileName))
+            return fs->GetFullName(fileName);
+
+        return {};
+    }
+
+    void FileSystem::Prefetch(const std::vector<std::string> &fileNames)
+    {
+        EnsureDefaultFileSystemRegistered();
+
+        // A single worker is enough, prefetching only issues hints and never wait for the I/O to complete
+        static ThreadPool worker(1);
+        worker.Enqueue([fileNames] {
+            // Owners are resolved by the worker, so FileSystems that dismounted in the meantime are never touched
+            // The lock is held per file, so Mount and InvalidateCache are not stalled by the whole list
+            for (auto &fileName : fileNames)
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                if (auto fs = Resolve(fileName))
+                    fs->Prefetch(fileName);
+            }
+        });
+    }
+
+    void FileSystem::InvalidateCache()
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::unique_lock<std::shared_mutex> cacheLock(m_cacheMutex);
+
+        m_cache.clear();
+    }
+
+    void FileSystem::Insert(std::unique_ptr<IFileSystem> fs, int priority)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::unique_lock<std::shared_mutex> cacheLock(m_cacheMutex);
+
+        // Most recently mounted FileSystem comes first among FileSystems with equal priority
+        auto position = std::find_if(m_systems.begin(), m_systems.end(), [&] (auto &mount) { return mount.Priority <= priority; });
+        m_systems.insert(position, MountPoint{ std::move(fs), priority });
+        m_cache.clear();
+    }
+
+    bool FileSystem::Remove(const std::function<bool(IFileSystem*)> &predicate)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::unique_lock<std::shared_mutex> cacheLock(m_cacheMutex);
+
+        auto count = m_systems.size();
+        m_systems.erase(std::remove_if(m_systems.begin(), m_systems.end(), [&] (auto &mount) { return predicate(mount.System.get()); }), m_systems.end());
+        if (m_systems.size() == count)
+            return false;
+
+        m_cache.clear();
+        return true;
+    }
+
+    IFileSystem *FileSystem::Resolve(const std::string &fileName)
+    {
+        // The caller must hold m_mutex, so mounted FileSystems cannot change during the lookup
         {
-            auto local = dynamic_cast<LocalFileSystem*>(fs.get());
-            if (!local)
-                continue;
+            std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+            if (auto it = m_cache.find(fileName); it != m_cache.end())
+                return it->second;
+        }
 
-            if (local->IsExists(fileName))
-                return local->GetFullName(fileName);
+        IFileSystem *owner = nullptr;
+        for (auto &mount : m_systems)
+        {
+            if (mount.System->IsExists(fileName))
+            {
+                owner = mount.System.get();
+                break;
+            }
         }
 
-        return {};
+        std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+        m_cache.emplace(fileName, owner);
+
+        return owner;
     }
 }
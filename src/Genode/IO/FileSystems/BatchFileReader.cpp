@@ -0,0 +1,606 @@
+#include <Genode/IO/FileSystems/BatchFileReader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <Genode/System/ThreadPool.hpp>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define GENODE_IO_URING
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+namespace Gx
+{
+    struct BatchFileReader::Batch
+    {
+        std::vector<Request>                      Requests;
+        Callback                                  OnComplete;
+        std::function<void(std::exception_ptr)>   OnFinish;
+        std::atomic<std::size_t>                  Remaining = 0;
+        std::mutex                                ErrorMutex;
+        std::exception_ptr                        Error;
+
+        void Complete(Result &result)
+        {
+            try
+            {
+                OnComplete(result);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(ErrorMutex);
+                if (!Error)
+                    Error = std::current_exception();
+            }
+
+            if (Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                OnFinish(Error);
+        }
+    };
+
+    namespace
+    {
+        // Point the result to the buffer that will receive the file content, the caller-owned buffer is preferred
+        int PrepareBuffer(const BatchFileReader::Request &request, BatchFileReader::Result &result, std::size_t size)
+        {
+            result.Size = size;
+            if (request.Buffer)
+            {
+                if (size > request.Capacity)
+                    return EFBIG;
+
+                result.Data = request.Buffer;
+                return 0;
+            }
+
+            result.Storage.resize(size);
+            result.Data = result.Storage.data();
+
+            return 0;
+        }
+    }
+
+#ifdef GENODE_IO_URING
+    // Minimal io_uring binding over the raw system calls, the ring is only accessed by the submitter thread
+    class BatchFileReader::Ring
+    {
+    public:
+        static std::unique_ptr<Ring> Create(unsigned entries)
+        {
+            auto ring = std::unique_ptr<Ring>(new Ring());
+            if (!ring->Setup(entries))
+                return nullptr;
+
+            return ring;
+        }
+
+        ~Ring()
+        {
+            if (m_sqes)
+                munmap(m_sqes, m_sqesSize);
+
+            if (m_cqRing && m_cqRing != m_sqRing)
+                munmap(m_cqRing, m_cqRingSize);
+
+            if (m_sqRing)
+                munmap(m_sqRing, m_sqRingSize);
+
+            if (m_fd >= 0)
+                close(m_fd);
+        }
+
+        unsigned GetCapacity() const
+        {
+            return m_entries;
+        }
+
+        io_uring_sqe *GetSqe()
+        {
+            auto head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            if (m_sqTail - head >= m_entries)
+                return nullptr;
+
+            auto index = m_sqTail & *m_sqMask;
+            m_sqArray[index] = index;
+            m_sqTail++;
+
+            auto sqe = &m_sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+
+            return sqe;
+        }
+
+        int Submit(unsigned waitCount)
+        {
+            __atomic_store_n(m_sqTailPtr, m_sqTail, __ATOMIC_RELEASE);
+            auto count = m_sqTail - m_submitted;
+            while (true)
+            {
+                auto flags  = waitCount > 0 ? IORING_ENTER_GETEVENTS : 0u;
+                auto result = static_cast<int>(syscall(__NR_io_uring_enter, m_fd, count, waitCount, flags, nullptr, 0));
+                if (result >= 0)
+                {
+                    m_submitted += static_cast<unsigned>(result);
+                    if (static_cast<unsigned>(result) >= count)
+                        return 0;
+
+                    count -= static_cast<unsigned>(result);
+                    continue;
+                }
+                else if (errno == EINTR)
+                    continue;
+
+                return errno;
+            }
+        }
+
+        int Wait()
+        {
+            // Nothing is submitted, the call only block until a completion is posted
+            auto result = syscall(__NR_io_uring_enter, m_fd, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+            return result < 0 ? errno : 0;
+        }
+
+        unsigned Discard()
+        {
+            // Entries that not consumed by the kernel are never processed, they are dropped from the submission queue
+            auto head  = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            auto count = m_sqTail - head;
+
+            m_sqTail    = head;
+            m_submitted = head;
+            __atomic_store_n(m_sqTailPtr, m_sqTail, __ATOMIC_RELEASE);
+
+            return count;
+        }
+
+        bool Pop(io_uring_cqe &cqe)
+        {
+            auto head = *m_cqHead;
+            if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+                return false;
+
+            cqe = m_cqes[head & *m_cqMask];
+            __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+    private:
+        Ring() = default;
+
+        bool Setup(unsigned entries)
+        {
+            io_uring_params params = {};
+            m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (m_fd < 0)
+                return false;
+
+            // Opening files through the ring require 5.6 kernel, older kernels use the pooled reads
+            if (!IsSupported(IORING_OP_OPENAT) || !IsSupported(IORING_OP_READ))
+                return false;
+
+            m_entries    = params.sq_entries;
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            if (params.features & IORING_FEAT_SINGLE_MMAP)
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+            m_sqRing = Map(m_sqRingSize, IORING_OFF_SQ_RING);
+            if (!m_sqRing)
+                return false;
+
+            m_cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? m_sqRing : Map(m_cqRingSize, IORING_OFF_CQ_RING);
+            if (!m_cqRing)
+                return false;
+
+            m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            m_sqes     = static_cast<io_uring_sqe*>(Map(m_sqesSize, IORING_OFF_SQES));
+            if (!m_sqes)
+                return false;
+
+            auto sq = static_cast<unsigned char*>(m_sqRing);
+            auto cq = static_cast<unsigned char*>(m_cqRing);
+            m_sqHead    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            m_sqTailPtr = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqMask    = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqArray   = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            m_cqHead    = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail    = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqMask    = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes      = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            m_sqTail    = *m_sqTailPtr;
+            m_submitted = m_sqTail;
+
+            return true;
+        }
+
+        bool IsSupported(unsigned opcode) const
+        {
+            constexpr unsigned capacity = 256;
+            std::vector<unsigned char> buffer(sizeof(io_uring_probe) + capacity * sizeof(io_uring_probe_op));
+
+            auto probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+            if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, capacity) < 0)
+                return false;
+
+            return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+        }
+
+        void *Map(std::size_t size, off_t offset) const
+        {
+            auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+            return data == MAP_FAILED ? nullptr : data;
+        }
+
+        int           m_fd         = -1;
+        unsigned      m_entries    = 0;
+        void         *m_sqRing     = nullptr;
+        void         *m_cqRing     = nullptr;
+        std::size_t   m_sqRingSize = 0;
+        std::size_t   m_cqRingSize = 0;
+        io_uring_sqe *m_sqes       = nullptr;
+        std::size_t   m_sqesSize   = 0;
+        unsigned     *m_sqHead     = nullptr;
+        unsigned     *m_sqTailPtr  = nullptr;
+        unsigned     *m_sqMask     = nullptr;
+        unsigned     *m_sqArray    = nullptr;
+        unsigned     *m_cqHead     = nullptr;
+        unsigned     *m_cqTail     = nullptr;
+        unsigned     *m_cqMask     = nullptr;
+        io_uring_cqe *m_cqes       = nullptr;
+        unsigned      m_sqTail     = 0;
+        unsigned      m_submitted  = 0;
+    };
+#else
+    class BatchFileReader::Ring
+    {
+    };
+#endif
+
+    BatchFileReader::BatchFileReader(std::size_t queueDepth, bool useUring) :
+        m_queueDepth(std::max<std::size_t>(queueDepth, 1))
+    {
+#ifdef GENODE_IO_URING
+        if (useUring)
+            m_ring = Ring::Create(static_cast<unsigned>(std::min<std::size_t>(m_queueDepth, 4096)));
+#else
+        (void)useUring;
+#endif
+
+        if (m_ring)
+            m_submitter = std::make_unique<ThreadPool>(1);
+    }
+
+    BatchFileReader::~BatchFileReader()
+    {
+        // Pending batches still reference the ring, so the threads are joined first
+        m_submitter.reset();
+        m_workers.reset();
+    }
+
+    bool BatchFileReader::IsUringEnabled() const
+    {
+        return m_ring && !m_ringFailed.load(std::memory_order_acquire);
+    }
+
+    std::future<void> BatchFileReader::Read(std::vector<Request> requests, Callback callback)
+    {
+        auto promise = std::make_shared<std::promise<void>>();
+        auto future  = promise->get_future();
+
+        auto batch        = std::make_shared<Batch>();
+        batch->Requests   = std::move(requests);
+        batch->OnComplete = std::move(callback);
+        batch->OnFinish   = [promise] (std::exception_ptr error) {
+            if (error)
+                promise->set_exception(error);
+            else
+                promise->set_value();
+        };
+
+        Process(batch);
+        return future;
+    }
+
+    std::future<std::vector<BatchFileReader::Result>> BatchFileReader::Read(std::vector<Request> requests)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<Result>>>();
+        auto results = std::make_shared<std::vector<Result>>(requests.size());
+        auto future  = promise->get_future();
+
+        // Each callback writes its own slot, the last completion publishes the whole vector
+        auto batch        = std::make_shared<Batch>();
+        batch->Requests   = std::move(requests);
+        batch->OnComplete = [results] (Result &result) { (*results)[result.Index] = std::move(result); };
+        batch->OnFinish   = [promise, results] (std::exception_ptr error) {
+            if (error)
+                promise->set_exception(error);
+            else
+                promise->set_value(std::move(*results));
+        };
+
+        Process(batch);
+        return future;
+    }
+
+    void BatchFileReader::ReadFile(const Request &request, Result &result)
+    {
+#ifdef _WIN32
+        std::FILE *file = nullptr;
+        if (fopen_s(&file, request.FileName.c_str(), "rb") != 0 || !file)
+        {
+            result.Error = errno ? errno : ENOENT;
+            return;
+        }
+
+        std::fseek(file, 0, SEEK_END);
+        auto size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+
+        if (size < 0)
+            result.Error = EIO;
+        else if ((result.Error = PrepareBuffer(request, result, static_cast<std::size_t>(size))) == 0)
+            result.Size = std::fread(result.Data, 1, result.Size, file);
+
+        std::fclose(file);
+#else
+        int fd = ::open(request.FileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            result.Error = errno;
+            return;
+        }
+
+        struct stat info = {};
+        if (fstat(fd, &info) != 0)
+            result.Error = errno;
+        else if (!S_ISREG(info.st_mode))
+            result.Error = EISDIR;
+        else if ((result.Error = PrepareBuffer(request, result, static_cast<std::size_t>(info.st_size))) == 0)
+        {
+            std::size_t offset = 0;
+            while (offset < result.Size)
+            {
+                auto bytes = pread(fd, static_cast<char*>(result.Data) + offset, result.Size - offset, static_cast<off_t>(offset));
+                if (bytes < 0 && errno == EINTR)
+                    continue;
+                else if (bytes < 0)
+                {
+                    result.Error = errno;
+                    break;
+                }
+                else if (bytes == 0)
+                    break;
+
+                offset += static_cast<std::size_t>(bytes);
+            }
+
+            // The file may shrink after its size is queried
+            result.Size = offset;
+        }
+
+        ::close(fd);
+#endif
+    }
+
+    void BatchFileReader::Process(const std::shared_ptr<Batch> &batch)
+    {
+        auto count = batch->Requests.size();
+        batch->Remaining.store(count, std::memory_order_relaxed);
+        if (count == 0)
+        {
+            batch->OnFinish(nullptr);
+            return;
+        }
+
+        if (!IsUringEnabled())
+        {
+            ProcessPooled(batch);
+            return;
+        }
+
+#ifdef GENODE_IO_URING
+        m_submitter->Enqueue([this, batch] {
+            enum class Stage { Open, Read };
+            struct State
+            {
+                Stage       Current = Stage::Open;
+                int         File    = -1;
+                std::size_t Offset  = 0;
+                bool        Done    = false;
+                Result      Outcome;
+            };
+
+            auto &requests = batch->Requests;
+            auto states    = std::vector<State>(requests.size());
+            auto complete  = [&] (std::size_t index, int error) {
+                auto &state = states[index];
+                if (state.File >= 0)
+                    ::close(state.File);
+
+                state.File          = -1;
+                state.Done          = true;
+                state.Outcome.Error = error;
+                batch->Complete(state.Outcome);
+            };
+
+            auto prepareRead = [&] (std::size_t index, io_uring_sqe *sqe) {
+                auto &state    = states[index];
+                auto remaining = std::min<std::size_t>(state.Outcome.Size - state.Offset, INT_MAX);
+
+                sqe->opcode    = IORING_OP_READ;
+                sqe->fd        = state.File;
+                sqe->addr      = reinterpret_cast<std::uint64_t>(static_cast<char*>(state.Outcome.Data) + state.Offset);
+                sqe->len       = static_cast<unsigned>(remaining);
+                sqe->off       = state.Offset;
+                sqe->user_data = index;
+            };
+
+            // The number of operations in flight never exceeds the ring capacity, so a submission queue entry is always available
+            std::size_t next = 0, inFlight = 0, completed = 0;
+            auto depth = std::min<std::size_t>(m_queueDepth, m_ring->GetCapacity());
+            while (completed < requests.size())
+            {
+                for (; next < requests.size() && inFlight < depth; next++, inFlight++)
+                {
+                    states[next].Outcome.Index    = next;
+                    states[next].Outcome.FileName = requests[next].FileName;
+
+                    auto sqe = m_ring->GetSqe();
+                    sqe->opcode     = IORING_OP_OPENAT;
+                    sqe->fd         = AT_FDCWD;
+                    sqe->addr       = reinterpret_cast<std::uint64_t>(requests[next].FileName.c_str());
+                    sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                    sqe->user_data  = next;
+                }
+
+                if (auto error = m_ring->Submit(1); error != 0 && error != EBUSY && error != EAGAIN)
+                {
+                    // The ring only rejects submissions that it cannot process at all, so the remaining requests
+                    // and the next batches are read on the ThreadPool instead
+                    m_ringFailed.store(true, std::memory_order_release);
+
+                    // Operations consumed by the kernel still write into the buffers, they must be reaped before the buffers are released
+                    inFlight -= m_ring->Discard();
+                    while (inFlight > 0)
+                    {
+                        io_uring_cqe cqe;
+                        while (m_ring->Pop(cqe))
+                        {
+                            auto &state = states[static_cast<std::size_t>(cqe.user_data)];
+                            if (state.Current == Stage::Open && cqe.res >= 0)
+                                state.File = cqe.res;
+
+                            inFlight--;
+                        }
+
+                        if (inFlight > 0 && m_ring->Wait() != 0)
+                            std::this_thread::yield();
+                    }
+
+                    for (std::size_t index = 0; index < requests.size(); index++)
+                    {
+                        auto &state = states[index];
+                        if (state.Done)
+                            continue;
+
+                        if (state.File >= 0)
+                            ::close(state.File);
+
+                        ReadPooled(batch, index);
+                    }
+
+                    return;
+                }
+
+                io_uring_cqe cqe;
+                while (m_ring->Pop(cqe))
+                {
+                    auto index  = static_cast<std::size_t>(cqe.user_data);
+                    auto &state = states[index];
+                    inFlight--;
+
+                    if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+                    {
+                        // Transient failures are resubmitted as they are
+                        auto sqe = m_ring->GetSqe();
+                        if (state.Current == Stage::Read)
+                            prepareRead(index, sqe);
+                        else
+                        {
+                            sqe->opcode     = IORING_OP_OPENAT;
+                            sqe->fd         = AT_FDCWD;
+                            sqe->addr       = reinterpret_cast<std::uint64_t>(requests[index].FileName.c_str());
+                            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                            sqe->user_data  = index;
+                        }
+
+                        inFlight++;
+                        continue;
+                    }
+                    else if (cqe.res < 0)
+                    {
+                        complete(index, -cqe.res);
+                        completed++;
+                        continue;
+                    }
+
+                    if (state.Current == Stage::Open)
+                    {
+                        // The inode is already loaded by the open, so querying the size does not touch the device
+                        state.File    = cqe.res;
+                        state.Current = Stage::Read;
+
+                        struct stat info = {};
+                        int error = fstat(state.File, &info) != 0 ? errno : (!S_ISREG(info.st_mode) ? EISDIR : 0);
+                        if (error == 0)
+                            error = PrepareBuffer(requests[index], state.Outcome, static_cast<std::size_t>(info.st_size));
+
+                        if (error != 0 || state.Outcome.Size == 0)
+                        {
+                            complete(index, error);
+                            completed++;
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        state.Offset += static_cast<std::size_t>(cqe.res);
+                        if (cqe.res == 0 || state.Offset >= state.Outcome.Size)
+                        {
+                            // The file may shrink after its size is queried
+                            state.Outcome.Size = state.Offset;
+                            complete(index, 0);
+                            completed++;
+                            continue;
+                        }
+                    }
+
+                    prepareRead(index, m_ring->GetSqe());
+                    inFlight++;
+                }
+            }
+        });
+#endif
+    }
+
+    void BatchFileReader::ProcessPooled(const std::shared_ptr<Batch> &batch)
+    {
+        // Each worker blocks on one file at a time, so the queue depth is bounded by the number of workers
+        for (std::size_t index = 0; index < batch->Requests.size(); index++)
+            ReadPooled(batch, index);
+    }
+
+    void BatchFileReader::ReadPooled(const std::shared_ptr<Batch> &batch, std::size_t index)
+    {
+        // Workers are only created when needed, since they stay idle for as long as io_uring works
+        std::call_once(m_workersCreated, [this] { m_workers = std::make_unique<ThreadPool>(); });
+
+        m_workers->Enqueue([batch, index] {
+            Result result;
+            result.Index    = index;
+            result.FileName = batch->Requests[index].FileName;
+
+            ReadFile(batch->Requests[index], result);
+            batch->Complete(result);
+        });
+    }
+}
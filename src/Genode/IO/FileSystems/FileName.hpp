@@ -0,0 +1,32 @@
+#ifndef GENODE_FILE_NAME_HPP
+#define GENODE_FILE_NAME_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace Gx
+{
+    // Normalize a relative file name into its indexed form: forward slash separators without leading "./" or "/".
+    // The buffer is only used when the name has to be rewritten, so already normalized names never allocate.
+    inline std::string_view NormalizeFileName(const std::string &fileName, std::string &buffer)
+    {
+        auto name = std::string_view(fileName);
+        if (name.find('\\') != std::string_view::npos)
+        {
+            buffer = fileName;
+            std::replace(buffer.begin(), buffer.end(), '\\', '/');
+            name = buffer;
+        }
+
+        while (name.size() >= 2 && name[0] == '.' && name[1] == '/')
+            name.remove_prefix(2);
+
+        while (!name.empty() && name[0] == '/')
+            name.remove_prefix(1);
+
+        return name;
+    }
+}
+
+#endif //GENODE_FILE_NAME_HPP
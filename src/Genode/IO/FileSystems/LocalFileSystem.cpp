@@ -1,37 +1,163 @@
 #include <Genode/IO/FileSystems/LocalFileSystem.hpp>
+#include <Genode/IO/FileSystems/FileName.hpp>
+#include <Genode/IO/MappedInputStream.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <future>
+#include <thread>
 
 #include <SFML/System/FileInputStream.hpp>
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    // Names that point outside of the root cannot be answered by the index
+    bool IsIndexable(const std::string &fileName)
+    {
+        if (!fileName.empty() && (fileName[0] == '/' || fileName[0] == '\\'))
+            return false;
+
+        if (fileName.size() >= 2 && fileName[1] == ':')
+            return false;
+
+        return fileName.find("..") == std::string::npos;
+    }
+}
+
 namespace Gx
 {
     LocalFileSystem::LocalFileSystem() :
-        m_root()
+        m_root(),
+        m_index(),
+        m_mapped(false)
     {
     }
 
     LocalFileSystem::LocalFileSystem(const std::string &root) :
-        m_root(root)
+        m_root(root),
+        m_index(),
+        m_mapped(false)
+    {
+    }
+
+    void LocalFileSystem::UseIndex(bool index)
+    {
+        if (index)
+            Rescan();
+        else
+        {
+            std::atomic_store(&m_index, std::shared_ptr<const Index>());
+            FileSystem::InvalidateCache();
+        }
+    }
+
+    void LocalFileSystem::UseMemoryMapping(bool mapping)
+    {
+        m_mapped = mapping;
+    }
+
+    void LocalFileSystem::Rescan()
+    {
+        namespace fs = std::filesystem;
+
+        auto root  = m_root.empty() ? fs::path(".") : m_root;
+        auto index = std::make_shared<Index>();
+        auto add   = [&] (Index &target, const fs::directory_entry &entry) {
+            std::error_code error;
+            if (!entry.is_regular_file(error))
+                return;
+
+            auto name = entry.path().lexically_relative(root).generic_string();
+            auto size = entry.file_size(error);
+            target[name] = IndexEntry{ static_cast<std::size_t>(error ? 0 : size), GetDiskName(name) };
+        };
+
+        // Files of the root are indexed directly, while subdirectories are shared among the scanning threads
+        std::error_code error;
+        auto directories = std::vector<fs::path>();
+        for (auto it = fs::directory_iterator(root, error); !error && it != fs::directory_iterator(); it.increment(error))
+        {
+            std::error_code type;
+            if (it->is_directory(type))
+                directories.push_back(it->path());
+            else
+                add(*index, *it);
+        }
+
+        auto workerCount = std::min<std::size_t>(directories.size(), std::max(1u, std::thread::hardware_concurrency()));
+        auto parts = std::vector<std::future<Index>>();
+        for (std::size_t worker = 0; worker < workerCount; worker++)
+        {
+            parts.push_back(std::async(std::launch::async, [&, worker] () {
+                auto part = Index();
+                for (std::size_t i = worker; i < directories.size(); i += workerCount)
+                {
+                    std::error_code walk;
+                    auto options = fs::directory_options::skip_permission_denied;
+                    for (auto it = fs::recursive_directory_iterator(directories[i], options, walk); !walk && it != fs::recursive_directory_iterator(); it.increment(walk))
+                        add(part, *it);
+                }
+
+                return part;
+            }));
+        }
+
+        for (auto &part : parts)
+        {
+            auto result = part.get();
+            index->merge(result);
+        }
+
+        std::atomic_store(&m_index, std::shared_ptr<const Index>(std::move(index)));
+        FileSystem::InvalidateCache();
+    }
+
+    std::future<void> LocalFileSystem::ReadBatch(const std::vector<std::string> &fileNames, BatchFileReader::Callback callback)
     {
+        return GetBatchReader().Read(CreateRequests(fileNames), std::move(callback));
+    }
+
+    std::future<std::vector<BatchFileReader::Result>> LocalFileSystem::ReadBatch(const std::vector<std::string> &fileNames)
+    {
+        return GetBatchReader().Read(CreateRequests(fileNames));
     }
 
     bool LocalFileSystem::IsExists(const std::string &fileName) const
     {
-        return std::filesystem::exists(GetFullName(fileName));
+        if (auto index = GetIndex(); index && IsIndexable(fileName))
+            return FindEntry(*index, fileName) != nullptr;
+
+        return std::filesystem::exists(GetDiskName(fileName));
     }
 
     std::string LocalFileSystem::GetFullName(const std::string &fileName) const
     {
-        auto fullName = std::filesystem::path(fileName);
-        if (!m_root.empty())
-            fullName = m_root / fullName;
+        if (auto index = GetIndex(); index && IsIndexable(fileName))
+        {
+            if (auto entry = FindEntry(*index, fileName))
+                return entry->FullName;
+        }
 
-        return fullName.string();
+        return GetDiskName(fileName);
     }
 
     std::unique_ptr<sf::InputStream> LocalFileSystem::Open(const std::string &fileName)
     {
+        if (m_mapped)
+        {
+            auto file = std::make_shared<MappedFile>();
+            if (!file->Open(GetFullName(fileName)))
+                return nullptr;
+
+            return std::make_unique<MappedInputStream>(std::move(file));
+        }
+
         auto stream = std::make_unique<sf::FileInputStream>();
         if (!stream->open(GetFullName(fileName)))
             return nullptr;
@@ -39,6 +165,16 @@ namespace Gx
         return stream;
     }
 
+    MappedView LocalFileSystem::Map(const std::string &fileName)
+    {
+        auto file = std::make_shared<MappedFile>();
+        if (!file->Open(GetFullName(fileName)))
+            return {};
+
+        auto size = file->GetSize();
+        return MappedView(std::move(file), 0, size);
+    }
+
     size_t LocalFileSystem::Read(const std::string &fileName, void *data)
     {
         return Read(fileName, data, 0);
@@ -46,6 +182,21 @@ namespace Gx
 
     std::size_t LocalFileSystem::Read(const std::string &fileName, void *data, std::size_t size)
     {
+        if (m_mapped)
+        {
+            auto view = Map(fileName);
+            if (!view)
+                return -1;
+
+            if (size <= 0 || size > view.GetSize())
+                size = view.GetSize();
+
+            if (size > 0)
+                std::memcpy(data, view.GetData(), size);
+
+            return size;
+        }
+
         auto stream = sf::FileInputStream();
         if (!stream.open(GetFullName(fileName)))
             return -1;
@@ -60,12 +211,117 @@ namespace Gx
         return stream.read(data, size);
     }
 
-    std::size_t LocalFileSystem::GetFileSize(const std::string &fileName)
+    BufferPool::Buffer LocalFileSystem::ReadAll(const std::string &fileName, BufferPool &pool)
     {
+        if (m_mapped)
+        {
+            auto view = Map(fileName);
+            if (!view)
+                return {};
+
+            auto buffer = pool.Acquire(view.GetSize());
+            if (view.GetSize() > 0)
+                std::memcpy(buffer.GetData(), view.GetData(), view.GetSize());
+
+            return buffer;
+        }
+
+        // The size is taken from the opened stream rather than GetFileSize, which would open the file a second time
         auto stream = sf::FileInputStream();
         if (!stream.open(GetFullName(fileName)))
+            return {};
+
+        auto size = stream.getSize();
+        if (size < 0)
+            return {};
+
+        auto buffer = pool.Acquire(static_cast<std::size_t>(size));
+        if (size > 0)
+        {
+            auto count = stream.read(buffer.GetData(), size);
+            if (count < 0)
+                return {};
+
+            buffer.Shrink(static_cast<std::size_t>(count));
+        }
+
+        return buffer;
+    }
+
+    std::size_t LocalFileSystem::GetFileSize(const std::string &fileName)
+    {
+        if (auto index = GetIndex(); index && IsIndexable(fileName))
+        {
+            auto entry = FindEntry(*index, fileName);
+            return entry ? entry->Size : -1;
+        }
+
+        auto stream = sf::FileInputStream();
+        if (!stream.open(GetDiskName(fileName)))
             return -1;
 
         return stream.getSize();
     }
-}
\ No newline at end of file
+
+    void LocalFileSystem::Prefetch(const std::string &fileName)
+    {
+#if defined(POSIX_FADV_WILLNEED)
+        // The kernel starts the readahead asynchronously, the descriptor can be closed right away
+        int fd = ::open(GetFullName(fileName).c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+#else
+        (void)fileName;
+#endif
+    }
+
+    BatchFileReader &LocalFileSystem::GetBatchReader()
+    {
+        static BatchFileReader reader;
+        return reader;
+    }
+
+    std::vector<BatchFileReader::Request> LocalFileSystem::CreateRequests(const std::vector<std::string> &fileNames) const
+    {
+        std::vector<BatchFileReader::Request> requests;
+        requests.reserve(fileNames.size());
+        for (auto &fileName : fileNames)
+            requests.push_back(BatchFileReader::Request{ GetFullName(fileName) });
+
+        return requests;
+    }
+
+    std::string LocalFileSystem::GetDiskName(const std::string &fileName) const
+    {
+        auto fullName = std::filesystem::path(fileName);
+        if (!m_root.empty())
+            fullName = m_root / fullName;
+
+        return fullName.string();
+    }
+
+    std::shared_ptr<const LocalFileSystem::Index> LocalFileSystem::GetIndex() const
+    {
+        return std::atomic_load(&m_index);
+    }
+
+    const LocalFileSystem::IndexEntry *LocalFileSystem::FindEntry(const Index &index, const std::string &fileName) const
+    {
+        if (auto it = index.find(fileName); it != index.end())
+            return &it->second;
+
+        // Only allocate when the name is not in its indexed form
+        auto buffer = std::string();
+        auto name   = NormalizeFileName(fileName, buffer);
+        if (name == fileName)
+            return nullptr;
+
+        if (auto it = index.find(std::string(name)); it != index.end())
+            return &it->second;
+
+        return nullptr;
+    }
+}
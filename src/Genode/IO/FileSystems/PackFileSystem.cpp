@@ -0,0 +1,254 @@
+#include <Genode/IO/FileSystems/PackFileSystem.hpp>
+#include <Genode/IO/FileSystems/PackFormat.hpp>
+#include <Genode/IO/FileSystems/FileName.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <Genode/IO/IOException.hpp>
+#include <Genode/IO/MappedInputStream.hpp>
+
+namespace Gx
+{
+    PackFileSystem::PackFileSystem(const std::string &archive) :
+        m_archive(std::make_shared<MappedFile>()),
+        m_table(nullptr),
+        m_names(nullptr),
+        m_count(0)
+    {
+        if (!m_archive->Open(archive))
+            throw IOException("[" + archive + "] Failed to open packed archive.");
+
+        auto data = m_archive->GetData();
+        auto size = m_archive->GetSize();
+        if (size < Pack::HeaderSize || std::memcmp(data, Pack::Magic, sizeof(Pack::Magic)) != 0)
+            throw IOException("[" + archive + "] File is not a packed archive.");
+
+        if (Pack::ReadU32(data + 4) != Pack::Version)
+            throw IOException("[" + archive + "] Unsupported packed archive version.");
+
+        auto count  = static_cast<std::size_t>(Pack::ReadU32(data + 8));
+        auto offset = Pack::ReadU64(data + 16);
+        if (offset > size || (size - offset) / Pack::EntrySize < count)
+            throw IOException("[" + archive + "] Packed archive table of contents is corrupted.");
+
+        m_table = data + offset;
+        m_names = m_table + count * Pack::EntrySize;
+        m_count = count;
+
+        // Validate every entry once, so lookups do not have to check the bounds
+        auto namesSize = size - (m_names - data);
+        auto previous  = std::string_view();
+        for (std::size_t i = 0; i < m_count; i++)
+        {
+            auto record     = m_table + i * Pack::EntrySize;
+            auto dataOffset = Pack::ReadU64(record);
+            auto dataSize   = Pack::ReadU64(record + 8);
+            auto nameOffset = Pack::ReadU32(record + 16);
+            auto nameLength = Pack::ReadU32(record + 20);
+
+            if (dataOffset > size || dataSize > size - dataOffset || nameOffset > namesSize || nameLength > namesSize - nameOffset)
+                throw IOException("[" + archive + "] Packed archive entry is out of bounds.");
+
+            auto name = GetEntryName(record);
+            if (i > 0 && !(previous < name))
+                throw IOException("[" + archive + "] Packed archive table of contents is not sorted.");
+
+            previous = name;
+        }
+    }
+
+    bool PackFileSystem::IsExists(const std::string &fileName) const
+    {
+        return FindEntry(fileName) != nullptr;
+    }
+
+    std::unique_ptr<sf::InputStream> PackFileSystem::Open(const std::string &fileName)
+    {
+        auto record = FindEntry(fileName);
+        if (!record)
+            return nullptr;
+
+        auto entry = GetEntry(record);
+        return std::make_unique<MappedInputStream>(m_archive, entry.Offset, entry.Size);
+    }
+
+    MappedView PackFileSystem::Map(const std::string &fileName)
+    {
+        auto record = FindEntry(fileName);
+        if (!record)
+            return {};
+
+        auto entry = GetEntry(record);
+        return MappedView(m_archive, entry.Offset, entry.Size);
+    }
+
+    std::size_t PackFileSystem::Read(const std::string &fileName, void *data)
+    {
+        return Read(fileName, data, 0);
+    }
+
+    std::size_t PackFileSystem::Read(const std::string &fileName, void *data, std::size_t size)
+    {
+        auto record = FindEntry(fileName);
+        if (!record)
+            return -1;
+
+        auto entry = GetEntry(record);
+        if (size <= 0 || size > entry.Size)
+            size = entry.Size;
+
+        if (size > 0)
+            std::memcpy(data, m_archive->GetData() + entry.Offset, size);
+
+        return size;
+    }
+
+    BufferPool::Buffer PackFileSystem::ReadAll(const std::string &fileName, BufferPool &pool)
+    {
+        auto record = FindEntry(fileName);
+        if (!record)
+            return {};
+
+        auto entry  = GetEntry(record);
+        auto buffer = pool.Acquire(entry.Size);
+        if (entry.Size > 0)
+            std::memcpy(buffer.GetData(), m_archive->GetData() + entry.Offset, entry.Size);
+
+        return buffer;
+    }
+
+    std::size_t PackFileSystem::GetFileSize(const std::string &fileName)
+    {
+        auto record = FindEntry(fileName);
+        if (!record)
+            return -1;
+
+        return GetEntry(record).Size;
+    }
+
+    void PackFileSystem::Prefetch(const std::string &fileName)
+    {
+        if (auto record = FindEntry(fileName))
+        {
+            auto entry = GetEntry(record);
+            m_archive->Prefetch(entry.Offset, entry.Size);
+        }
+    }
+
+    std::size_t PackFileSystem::GetEntryCount() const
+    {
+        return m_count;
+    }
+
+    const unsigned char *PackFileSystem::FindEntry(const std::string &fileName) const
+    {
+        auto buffer = std::string();
+        auto name   = NormalizeFileName(fileName, buffer);
+
+        std::size_t low = 0, high = m_count;
+        while (low < high)
+        {
+            auto middle = low + (high - low) / 2;
+            auto record = m_table + middle * Pack::EntrySize;
+            auto result = GetEntryName(record).compare(name);
+            if (result == 0)
+                return record;
+            else if (result < 0)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        return nullptr;
+    }
+
+    PackFileSystem::Entry PackFileSystem::GetEntry(const unsigned char *record) const
+    {
+        return { static_cast<std::size_t>(Pack::ReadU64(record)), static_cast<std::size_t>(Pack::ReadU64(record + 8)) };
+    }
+
+    std::string_view PackFileSystem::GetEntryName(const unsigned char *record) const
+    {
+        auto name = reinterpret_cast<const char*>(m_names + Pack::ReadU32(record + 16));
+        return { name, Pack::ReadU32(record + 20) };
+    }
+
+    void PackWriter::AddDirectory(const std::string &directory)
+    {
+        auto root = std::filesystem::path(directory);
+        for (auto &file : std::filesystem::recursive_directory_iterator(root))
+        {
+            if (file.is_regular_file())
+                AddFile(file.path().lexically_relative(root).generic_string(), file.path().string());
+        }
+    }
+
+    void PackWriter::AddFile(const std::string &name, const std::string &fileName)
+    {
+        auto buffer = std::string();
+        m_files[std::string(NormalizeFileName(name, buffer))] = fileName;
+    }
+
+    void PackWriter::Save(const std::string &archive) const
+    {
+        auto output = std::ofstream(archive, std::ios::binary | std::ios::trunc);
+        if (!output)
+            throw IOException("[" + archive + "] Failed to create packed archive.");
+
+        auto table  = std::string();
+        auto names  = std::string();
+        auto offset = static_cast<std::uint64_t>(Pack::HeaderSize);
+
+        // Header is rewritten once the table offset is known
+        output.write(std::string(Pack::HeaderSize, '\0').data(), Pack::HeaderSize);
+
+        auto buffer = std::vector<char>(1 << 16);
+        for (auto &[name, fileName] : m_files)
+        {
+            auto padding = (Pack::DataAlignment - offset % Pack::DataAlignment) % Pack::DataAlignment;
+            output.write(std::string(padding, '\0').data(), static_cast<std::streamsize>(padding));
+            offset += padding;
+
+            auto input = std::ifstream(fileName, std::ios::binary);
+            if (!input)
+                throw IOException("[" + fileName + "] Failed to read file to pack.");
+
+            std::uint64_t size = 0;
+            while (input)
+            {
+                input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                output.write(buffer.data(), input.gcount());
+                size += static_cast<std::uint64_t>(input.gcount());
+            }
+
+            Pack::WriteU64(table, offset);
+            Pack::WriteU64(table, size);
+            Pack::WriteU32(table, static_cast<std::uint32_t>(names.size()));
+            Pack::WriteU32(table, static_cast<std::uint32_t>(name.size()));
+            names += name;
+            offset += size;
+        }
+
+        auto header = std::string(Pack::Magic, sizeof(Pack::Magic));
+        Pack::WriteU32(header, Pack::Version);
+        Pack::WriteU32(header, static_cast<std::uint32_t>(m_files.size()));
+        Pack::WriteU32(header, 0);
+        Pack::WriteU64(header, offset);
+
+        output.write(table.data(), static_cast<std::streamsize>(table.size()));
+        output.write(names.data(), static_cast<std::streamsize>(names.size()));
+        output.seekp(0);
+        output.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        if (!output)
+            throw IOException("[" + archive + "] Failed to write packed archive.");
+    }
+
+    std::size_t PackWriter::GetEntryCount() const
+    {
+        return m_files.size();
+    }
+}
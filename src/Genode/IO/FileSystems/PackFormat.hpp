@@ -0,0 +1,45 @@
+#ifndef GENODE_PACK_FORMAT_HPP
+#define GENODE_PACK_FORMAT_HPP
+
+#include <cstdint>
+#include <string>
+
+// Archive layout, all integers are little-endian:
+//
+//   Header       : Magic[4] "GXPK", Version u32, EntryCount u32, Reserved u32, TableOffset u64
+//   File data    : Content of each file, aligned to PackDataAlignment
+//   Table        : EntryCount * { DataOffset u64, DataSize u64, NameOffset u32, NameLength u32 }, sorted by name
+//   Names        : Concatenated UTF-8 names with forward slash separator, NameOffset is relative to this block
+namespace Gx::Pack
+{
+    constexpr char          Magic[4]       = { 'G', 'X', 'P', 'K' };
+    constexpr std::uint32_t Version        = 1;
+    constexpr std::size_t   HeaderSize     = 24;
+    constexpr std::size_t   EntrySize      = 24;
+    constexpr std::size_t   DataAlignment  = 16;
+
+    inline std::uint32_t ReadU32(const unsigned char *data)
+    {
+        return static_cast<std::uint32_t>(data[0])       | static_cast<std::uint32_t>(data[1]) << 8 |
+               static_cast<std::uint32_t>(data[2]) << 16 | static_cast<std::uint32_t>(data[3]) << 24;
+    }
+
+    inline std::uint64_t ReadU64(const unsigned char *data)
+    {
+        return static_cast<std::uint64_t>(ReadU32(data)) | static_cast<std::uint64_t>(ReadU32(data + 4)) << 32;
+    }
+
+    inline void WriteU32(std::string &buffer, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    inline void WriteU64(std::string &buffer, std::uint64_t value)
+    {
+        WriteU32(buffer, static_cast<std::uint32_t>(value));
+        WriteU32(buffer, static_cast<std::uint32_t>(value >> 32));
+    }
+}
+
+#endif //GENODE_PACK_FORMAT_HPP
@@ -0,0 +1,67 @@
+#include <Genode/IO/Instrumentation.hpp>
+
+#include <algorithm>
+
+namespace Gx
+{
+    void LatencyHistogram::Add(IInstrumentationSink::Duration duration)
+    {
+        auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0));
+
+        std::size_t index = 0;
+        while (index < BucketCount - 1 && (std::uint64_t(1) << index) <= micros)
+            index++;
+
+        m_buckets[index]++;
+        m_count++;
+        m_total += duration;
+        m_max    = std::max(m_max, duration);
+    }
+
+    IInstrumentationSink::Duration LatencyHistogram::GetPercentile(double percentile) const
+    {
+        if (m_count == 0)
+            return {};
+
+        auto target = static_cast<std::uint64_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(m_count));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; i++)
+        {
+            seen += m_buckets[i];
+            if (seen > target || seen == m_count)
+                return std::min<IInstrumentationSink::Duration>(std::chrono::microseconds(std::uint64_t(1) << i), m_max);
+        }
+
+        return m_max;
+    }
+
+    void Instrumentation::SetSink(std::shared_ptr<IInstrumentationSink> sink)
+    {
+        bool enabled = sink != nullptr;
+        std::atomic_store(&m_sink, std::move(sink));
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<IInstrumentationSink> Instrumentation::GetSink()
+    {
+        return std::atomic_load(&m_sink);
+    }
+
+    void Instrumentation::DispatchLoad(const std::type_info &type, std::string_view id, IInstrumentationSink::Duration duration)
+    {
+        if (auto sink = GetSink())
+            sink->OnResourceLoaded(type, id, duration);
+    }
+
+    void Instrumentation::DispatchLookup(const std::type_info &type, std::string_view id, bool hit)
+    {
+        if (auto sink = GetSink())
+            sink->OnCacheLookup(type, id, hit);
+    }
+
+    void Instrumentation::DispatchFileAccess(FileOperation operation, const std::string &fileName, std::size_t bytes, IInstrumentationSink::Duration duration)
+    {
+        if (auto sink = GetSink())
+            sink->OnFileAccess(operation, fileName, bytes, duration);
+    }
+}
@@ -0,0 +1,53 @@
+#include <Genode/IO/InstrumentationRecorder.hpp>
+
+namespace Gx
+{
+    void InstrumentationRecorder::OnResourceLoaded(const std::type_info &type, std::string_view, Duration duration)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources[type.name()].Latency.Add(duration);
+    }
+
+    void InstrumentationRecorder::OnCacheLookup(const std::type_info &type, std::string_view, bool hit)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &stats = m_resources[type.name()];
+        if (hit)
+            stats.Hits++;
+        else
+            stats.Misses++;
+    }
+
+    void InstrumentationRecorder::OnFileAccess(FileOperation operation, const std::string &, std::size_t bytes, Duration duration)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (operation == FileOperation::Open)
+        {
+            m_files.OpenLatency.Add(duration);
+            return;
+        }
+
+        m_files.ReadLatency.Add(duration);
+        m_files.BytesRead += bytes;
+    }
+
+    std::map<std::string, ResourceLoadStats> InstrumentationRecorder::GetResourceStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_resources;
+    }
+
+    FileAccessStats InstrumentationRecorder::GetFileStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_files;
+    }
+
+    void InstrumentationRecorder::Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resources.clear();
+        m_files = {};
+    }
+}
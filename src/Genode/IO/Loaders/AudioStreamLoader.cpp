@@ -0,0 +1,47 @@
+#include <Genode/IO/Loaders/AudioStreamLoader.hpp>
+
+#include <vector>
+
+namespace Gx
+{
+    std::unique_ptr<AudioStream> AudioStreamLoader::LoadFromFile(const std::string &fileName, const ResourceContext &ctx)
+    {
+        auto resource = std::make_unique<AudioStream>();
+        if (!resource->OpenFromFile(fileName))
+            return nullptr;
+
+        return resource;
+    }
+
+    std::unique_ptr<AudioStream> AudioStreamLoader::LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx)
+    {
+        auto resource = std::make_unique<AudioStream>();
+        if (!resource->OpenFromMemory(data, size))
+            return nullptr;
+
+        return resource;
+    }
+
+    std::unique_ptr<AudioStream> AudioStreamLoader::LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx)
+    {
+        // The caller keeps the ownership of the stream, copy the compressed data since it must outlive the playback
+        std::vector<char> data;
+        auto size = stream.getSize();
+        if (size > 0)
+            data.reserve(static_cast<std::size_t>(size));
+
+        char buffer[16384];
+        sf::Int64 count;
+        while ((count = stream.read(buffer, sizeof(buffer))) > 0)
+            data.insert(data.end(), buffer, buffer + count);
+
+        if (count < 0 || data.empty())
+            return nullptr;
+
+        auto resource = std::make_unique<AudioStream>();
+        if (!resource->OpenFromMemory(std::move(data)))
+            return nullptr;
+
+        return resource;
+    }
+}
@@ -1,18 +1,51 @@
 #include <Genode/IO/Loaders/SoundBufferLoader.hpp>
 
+#include <Genode/IO/DecodeCache.hpp>
+#include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/Loaders/SourceBuffer.hpp>
+
 namespace Gx
 {
     std::unique_ptr<sf::SoundBuffer> SoundBufferLoader::LoadFromFile(const std::string &fileName, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+        {
+            SourceBuffer source;
+            if (!source.ReadFile(fileName))
+                return nullptr;
+
+            return LoadCached(source.GetData(), source.GetSize());
+        }
+
         auto resource = std::make_unique<sf::SoundBuffer>();
-        if (!resource->loadFromFile(fileName))
-            return nullptr;
+        auto fullName = Gx::FileSystem::GetFullName(fileName);
+        if (!fullName.empty())
+        {
+            if (!resource->loadFromFile(fullName))
+                return nullptr;
+        }
+        else if (auto view = Gx::FileSystem::Map(fileName))
+        {
+            // File is not located in the disk (e.g. packed archive), decode the mapped content in place
+            if (!resource->loadFromMemory(view.GetData(), view.GetSize()))
+                return nullptr;
+        }
+        else
+        {
+            // FileSystem of the file does not support mapping, read it into a pooled buffer instead
+            auto buffer = Gx::FileSystem::ReadAll(fileName);
+            if (!buffer || !resource->loadFromMemory(buffer.GetData(), buffer.GetSize()))
+                return nullptr;
+        }
 
         return resource;
     }
 
     std::unique_ptr<sf::SoundBuffer> SoundBufferLoader::LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+            return LoadCached(data, size);
+
         auto resource = std::make_unique<sf::SoundBuffer>();
         if (!resource->loadFromMemory(data, size))
             return nullptr;
@@ -22,10 +55,44 @@ namespace Gx
 
     std::unique_ptr<sf::SoundBuffer> SoundBufferLoader::LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+        {
+            SourceBuffer source;
+            if (!source.ReadStream(stream))
+                return nullptr;
+
+            return LoadCached(source.GetData(), source.GetSize());
+        }
+
         auto resource = std::make_unique<sf::SoundBuffer>();
         if (!resource->loadFromStream(stream))
             return nullptr;
 
         return resource;
     }
-}
\ No newline at end of file
+
+    std::unique_ptr<sf::SoundBuffer> SoundBufferLoader::LoadCached(const void *data, std::size_t size)
+    {
+        auto resource = std::make_unique<sf::SoundBuffer>();
+        auto key      = DecodeCache::CreateKey(DecodeCache::Format::Samples, data, size);
+        if (auto entry = DecodeCache::Find(key))
+        {
+            auto &properties = entry->GetProperties();
+            auto samples     = static_cast<const sf::Int16*>(entry->GetData());
+            auto count       = entry->GetSize() / sizeof(sf::Int16);
+            if (properties.ChannelCount > 0 && resource->loadFromSamples(samples, count, properties.ChannelCount, properties.SampleRate))
+                return resource;
+        }
+
+        if (!resource->loadFromMemory(data, size))
+            return nullptr;
+
+        if (auto samples = resource->getSamples())
+        {
+            auto properties = DecodeCache::Properties{ 0, 0, resource->getChannelCount(), resource->getSampleRate() };
+            DecodeCache::Store(key, properties, samples, static_cast<std::size_t>(resource->getSampleCount()) * sizeof(sf::Int16));
+        }
+
+        return resource;
+    }
+}
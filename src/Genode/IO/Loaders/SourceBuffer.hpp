@@ -0,0 +1,62 @@
+#ifndef GENODE_SOURCE_BUFFER_HPP
+#define GENODE_SOURCE_BUFFER_HPP
+
+#include <string>
+#include <vector>
+
+#include <SFML/System/InputStream.hpp>
+
+#include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/MappedView.hpp>
+
+namespace Gx
+{
+    // Holds the whole content of a resource source so it can be hashed before it is decoded.
+    // Files are mapped when their FileSystem support it, otherwise read into a pooled buffer. Streams are copied into memory.
+    class SourceBuffer
+    {
+    public:
+        bool ReadFile(const std::string &fileName)
+        {
+            m_view = Gx::FileSystem::Map(fileName);
+            if (m_view)
+                return true;
+
+            m_file = Gx::FileSystem::ReadAll(fileName);
+            return static_cast<bool>(m_file);
+        }
+
+        bool ReadStream(sf::InputStream &stream)
+        {
+            char buffer[16384];
+            sf::Int64 count;
+            while ((count = stream.read(buffer, sizeof(buffer))) > 0)
+                m_buffer.insert(m_buffer.end(), buffer, buffer + count);
+
+            return count == 0;
+        }
+
+        const void *GetData() const
+        {
+            if (m_view)
+                return m_view.GetData();
+
+            return m_file ? static_cast<const void*>(m_file.GetData()) : m_buffer.data();
+        }
+
+        std::size_t GetSize() const
+        {
+            if (m_view)
+                return m_view.GetSize();
+
+            return m_file ? m_file.GetSize() : m_buffer.size();
+        }
+
+    private:
+        MappedView         m_view;
+        BufferPool::Buffer m_file;
+        std::vector<char>  m_buffer;
+    };
+}
+
+#endif //GENODE_SOURCE_BUFFER_HPP
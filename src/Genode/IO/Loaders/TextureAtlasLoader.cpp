@@ -0,0 +1,190 @@
+#include <Genode/IO/Loaders/TextureAtlasLoader.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include <SFML/Graphics/Texture.hpp>
+
+#include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/IOException.hpp>
+#include <Genode/IO/ResourceContext.hpp>
+#include <Genode/IO/SkylinePacker.hpp>
+
+namespace Gx
+{
+    namespace
+    {
+        std::string Trim(const std::string &value)
+        {
+            auto begin = value.find_first_not_of(" \t\r");
+            if (begin == std::string::npos)
+                return {};
+
+            auto end = value.find_last_not_of(" \t\r");
+            return value.substr(begin, end - begin + 1);
+        }
+
+        std::string ReadAll(sf::InputStream &stream)
+        {
+            auto size = stream.getSize();
+            if (size <= 0)
+                return {};
+
+            std::string content(static_cast<std::size_t>(size), '\0');
+            auto read = stream.read(&content[0], size);
+            content.resize(static_cast<std::size_t>(std::max<sf::Int64>(read, 0)));
+
+            return content;
+        }
+
+        bool LoadImage(const std::string &fileName, sf::Image &image)
+        {
+            auto fullName = FileSystem::GetFullName(fileName);
+            if (!fullName.empty())
+                return image.loadFromFile(fullName);
+
+            // File is not located in the disk (e.g. packed archive), read it from mounted FileSystem instead
+            auto buffer = FileSystem::ReadAll(fileName);
+            return buffer && image.loadFromMemory(buffer.GetData(), buffer.GetSize());
+        }
+    }
+
+    void TextureAtlasLoader::UseSmooth(bool smooth)
+    {
+        m_smooth = smooth;
+    }
+
+    void TextureAtlasLoader::SetPageSize(unsigned size)
+    {
+        m_pageSize = std::max(size, 1u);
+    }
+
+    void TextureAtlasLoader::SetPadding(unsigned padding)
+    {
+        m_padding = padding;
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlasLoader::LoadFromFile(const std::string &fileName, const ResourceContext &ctx)
+    {
+        auto buffer = FileSystem::ReadAll(fileName);
+        if (!buffer)
+            return nullptr;
+
+        return LoadFromManifest(std::string(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetSize()), ctx);
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlasLoader::LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx)
+    {
+        return LoadFromManifest(std::string(static_cast<const char*>(data), size), ctx);
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlasLoader::LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx)
+    {
+        return LoadFromManifest(ReadAll(stream), ctx);
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlasLoader::LoadFromManifest(const std::string &manifest, const ResourceContext &ctx) const
+    {
+        std::vector<Image> images;
+        std::istringstream lines(manifest);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            auto separator = line.find('=');
+            auto name      = separator == std::string::npos ? line : Trim(line.substr(0, separator));
+            auto path      = separator == std::string::npos ? line : Trim(line.substr(separator + 1));
+
+            images.emplace_back(name, sf::Image());
+            if (!LoadImage(path, images.back().second))
+                throw ResourceLoadException("[" + path + "] Failed to load atlas image.");
+        }
+
+        return Build(std::move(images), ctx);
+    }
+
+    std::unique_ptr<TextureAtlas> TextureAtlasLoader::Build(std::vector<Image> images, const ResourceContext &ctx) const
+    {
+        // Packing the tallest images first keeps the skyline flat
+        std::vector<std::size_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&images] (std::size_t a, std::size_t b) {
+            auto sizeA = images[a].second.getSize(), sizeB = images[b].second.getSize();
+            return sizeA.y != sizeB.y ? sizeA.y > sizeB.y : sizeA.x > sizeB.x;
+        });
+
+        std::vector<SkylinePacker> packers;
+        std::vector<sf::Vector2u>  extents;
+        std::vector<TextureAtlas::Region> regions(images.size());
+        for (auto index : order)
+        {
+            auto size = images[index].second.getSize();
+            if (size.x > m_pageSize || size.y > m_pageSize)
+                throw ResourceLoadException("[" + images[index].first + "] Image is larger than the atlas texture.");
+
+            // Padding is only needed between images, so it may be dropped at the edge of the texture
+            auto width  = std::min(size.x + m_padding, m_pageSize);
+            auto height = std::min(size.y + m_padding, m_pageSize);
+
+            // Existing textures are tried first, so small images fill the gaps left by the larger ones
+            sf::Vector2u position;
+            std::size_t page = 0;
+            while (page < packers.size() && !packers[page].Insert(width, height, position))
+                page++;
+
+            if (page == packers.size())
+            {
+                packers.emplace_back(m_pageSize, m_pageSize);
+                extents.emplace_back(0, 0);
+                packers.back().Insert(width, height, position);
+            }
+
+            extents[page].x = std::max(extents[page].x, position.x + size.x);
+            extents[page].y = std::max(extents[page].y, position.y + size.y);
+            regions[index]  = { page, sf::IntRect(static_cast<int>(position.x), static_cast<int>(position.y), static_cast<int>(size.x), static_cast<int>(size.y)) };
+        }
+
+        // Textures are trimmed to the area that is occupied by the images
+        std::vector<std::shared_ptr<sf::Image>> pages;
+        for (auto &extent : extents)
+        {
+            pages.push_back(std::make_shared<sf::Image>());
+            pages.back()->create(std::max(extent.x, 1u), std::max(extent.y, 1u), sf::Color::Transparent);
+        }
+
+        auto atlas = std::make_unique<TextureAtlas>();
+        for (std::size_t i = 0; i < images.size(); i++)
+        {
+            auto &region = regions[i];
+            pages[region.Page]->copy(images[i].second, static_cast<unsigned>(region.Rect.left), static_cast<unsigned>(region.Rect.top));
+            atlas->AddRegion(images[i].first, region);
+        }
+
+        for (auto &image : pages)
+        {
+            auto page = atlas->AddTexture(std::make_unique<sf::Texture>());
+            if (ctx.IsUploadDeferred())
+            {
+                auto size  = image->getSize();
+                auto bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+                ctx.DeferUpload<TextureAtlas>(*atlas, bytes, [image, page, smooth = m_smooth] (IUploadSink &sink, TextureAtlas &target) {
+                    return sink.Upload(target.GetTexture(page), *image, smooth);
+                });
+
+                continue;
+            }
+
+            auto &texture = atlas->GetTexture(page);
+            if (!texture.loadFromImage(*image))
+                return nullptr;
+
+            texture.setSmooth(m_smooth);
+        }
+
+        return atlas;
+    }
+}
@@ -2,7 +2,9 @@
 #include <string>
 
 #include <Genode/IO/ResourceContext.hpp>
+#include <Genode/IO/DecodeCache.hpp>
 #include <Genode/IO/FileSystem.hpp>
+#include <Genode/IO/Loaders/SourceBuffer.hpp>
 
 namespace Gx
 {
@@ -13,9 +15,60 @@ namespace Gx
 
     std::unique_ptr<sf::Texture> TextureLoader::LoadFromFile(const std::string &fileName, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+        {
+            SourceBuffer source;
+            if (!source.ReadFile(fileName))
+                return nullptr;
+
+            return LoadCached(source.GetData(), source.GetSize(), ctx);
+        }
+
+        if (ctx.IsUploadDeferred())
+        {
+            auto image    = std::make_unique<sf::Image>();
+            auto fullName = Gx::FileSystem::GetFullName(fileName);
+            if (!fullName.empty())
+            {
+                if (!image->loadFromFile(fullName))
+                    return nullptr;
+            }
+            else if (auto view = Gx::FileSystem::Map(fileName))
+            {
+                // File is not located in the disk (e.g. packed archive), decode the mapped content in place
+                if (!image->loadFromMemory(view.GetData(), view.GetSize()))
+                    return nullptr;
+            }
+            else
+            {
+                auto buffer = Gx::FileSystem::ReadAll(fileName);
+                if (!buffer || !image->loadFromMemory(buffer.GetData(), buffer.GetSize()))
+                    return nullptr;
+            }
+
+            return Stage(std::move(image), ctx);
+        }
+
         auto resource = std::make_unique<sf::Texture>();
-        if (!resource->loadFromFile(Gx::FileSystem::GetFullName(fileName)))
-            return nullptr;
+        auto fullName = Gx::FileSystem::GetFullName(fileName);
+        if (!fullName.empty())
+        {
+            if (!resource->loadFromFile(fullName))
+                return nullptr;
+        }
+        else if (auto view = Gx::FileSystem::Map(fileName))
+        {
+            // File is not located in the disk (e.g. packed archive), decode the mapped content in place
+            if (!resource->loadFromMemory(view.GetData(), view.GetSize()))
+                return nullptr;
+        }
+        else
+        {
+            // FileSystem of the file does not support mapping, read it into a pooled buffer instead
+            auto buffer = Gx::FileSystem::ReadAll(fileName);
+            if (!buffer || !resource->loadFromMemory(buffer.GetData(), buffer.GetSize()))
+                return nullptr;
+        }
 
         resource->setSmooth(m_smooth);
         return resource;
@@ -23,6 +76,18 @@ namespace Gx
 
     std::unique_ptr<sf::Texture> TextureLoader::LoadFromMemory(void *data, std::size_t size, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+            return LoadCached(data, size, ctx);
+
+        if (ctx.IsUploadDeferred())
+        {
+            auto image = std::make_unique<sf::Image>();
+            if (!image->loadFromMemory(data, size))
+                return nullptr;
+
+            return Stage(std::move(image), ctx);
+        }
+
         auto resource = std::make_unique<sf::Texture>();
         if (!resource->loadFromMemory(data, size))
             return nullptr;
@@ -33,6 +98,24 @@ namespace Gx
 
     std::unique_ptr<sf::Texture> TextureLoader::LoadFromStream(sf::InputStream &stream, const ResourceContext &ctx)
     {
+        if (DecodeCache::IsEnabled())
+        {
+            SourceBuffer source;
+            if (!source.ReadStream(stream))
+                return nullptr;
+
+            return LoadCached(source.GetData(), source.GetSize(), ctx);
+        }
+
+        if (ctx.IsUploadDeferred())
+        {
+            auto image = std::make_unique<sf::Image>();
+            if (!image->loadFromStream(stream))
+                return nullptr;
+
+            return Stage(std::move(image), ctx);
+        }
+
         auto resource = std::make_unique<sf::Texture>();
         if (!resource->loadFromStream(stream))
             return nullptr;
@@ -40,5 +123,66 @@ namespace Gx
         resource->setSmooth(m_smooth);
         return resource;
     }
-}
 
+    std::unique_ptr<sf::Texture> TextureLoader::LoadCached(const void *data, std::size_t size, const ResourceContext &ctx) const
+    {
+        auto key = DecodeCache::CreateKey(DecodeCache::Format::Image, data, size);
+        if (auto entry = DecodeCache::Find(key))
+        {
+            auto &properties = entry->GetProperties();
+            auto pixels      = static_cast<const sf::Uint8*>(entry->GetData());
+            if (entry->GetSize() == static_cast<std::size_t>(properties.Width) * properties.Height * 4)
+            {
+                if (ctx.IsUploadDeferred())
+                {
+                    auto image = std::make_unique<sf::Image>();
+                    image->create(properties.Width, properties.Height, pixels);
+
+                    return Stage(std::move(image), ctx);
+                }
+
+                // Upload straight from the mapped entry, the pixels are never copied into an intermediate image
+                auto resource = std::make_unique<sf::Texture>();
+                if (!resource->create(properties.Width, properties.Height))
+                    return nullptr;
+
+                resource->update(pixels);
+                resource->setSmooth(m_smooth);
+                return resource;
+            }
+        }
+
+        auto image = std::make_unique<sf::Image>();
+        if (!image->loadFromMemory(data, size))
+            return nullptr;
+
+        auto imageSize = image->getSize();
+        if (auto pixels = image->getPixelsPtr())
+            DecodeCache::Store(key, { imageSize.x, imageSize.y, 0, 0 }, pixels, static_cast<std::size_t>(imageSize.x) * imageSize.y * 4);
+
+        if (ctx.IsUploadDeferred())
+            return Stage(std::move(image), ctx);
+
+        auto resource = std::make_unique<sf::Texture>();
+        if (!resource->loadFromImage(*image))
+            return nullptr;
+
+        resource->setSmooth(m_smooth);
+        return resource;
+    }
+
+    std::unique_ptr<sf::Texture> TextureLoader::Stage(std::unique_ptr<sf::Image> image, const ResourceContext &ctx) const
+    {
+        auto resource = std::make_unique<sf::Texture>();
+        auto size     = image->getSize();
+        auto bytes    = static_cast<std::size_t>(size.x) * size.y * 4;
+
+        // The upload function must be copyable, so the decoded image is shared instead of copied
+        auto pixels = std::shared_ptr<sf::Image>(std::move(image));
+        ctx.DeferUpload<sf::Texture>(*resource, bytes, [pixels, smooth = m_smooth] (IUploadSink &sink, sf::Texture &texture) {
+            return sink.Upload(texture, *pixels, smooth);
+        });
+
+        return resource;
+    }
+}
@@ -0,0 +1,151 @@
+#include <Genode/IO/MappedFile.hpp>
+
+#include <algorithm>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Gx
+{
+    MappedFile::MappedFile() :
+        m_data(nullptr),
+        m_size(0),
+        m_open(false)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::string &fileName)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // Empty file cannot be mapped, but it is still a valid file
+        if (size.QuadPart > 0)
+        {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(file);
+            if (!mapping)
+                return false;
+
+            auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!data)
+                return false;
+
+            m_data = static_cast<const unsigned char*>(data);
+        }
+        else
+            CloseHandle(file);
+
+        m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info = {};
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        // Empty file cannot be mapped, but it is still a valid file
+        if (info.st_size > 0)
+        {
+            auto data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            m_data = static_cast<const unsigned char*>(data);
+        }
+
+        ::close(fd);
+        m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+        m_open = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    void MappedFile::Prefetch(std::size_t offset, std::size_t size) const
+    {
+        if (!m_data || offset >= m_size || size == 0)
+            return;
+
+        size = std::min(size, m_size - offset);
+#ifdef _WIN32
+    #if _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range = { const_cast<unsigned char*>(m_data + offset), size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    #endif
+#else
+        // madvise require a page aligned address, the mapping itself is page aligned
+        auto page  = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        auto start = offset - offset % page;
+        madvise(const_cast<unsigned char*>(m_data + start), size + (offset - start), MADV_WILLNEED);
+#endif
+    }
+
+    bool MappedFile::IsOpen() const
+    {
+        return m_open;
+    }
+
+    const unsigned char *MappedFile::GetData() const
+    {
+        return m_data;
+    }
+
+    std::size_t MappedFile::GetSize() const
+    {
+        return m_size;
+    }
+}
@@ -0,0 +1,62 @@
+#include <Genode/IO/MappedInputStream.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Gx
+{
+    MappedInputStream::MappedInputStream(std::shared_ptr<const MappedFile> file) :
+        MappedInputStream(file, 0, file ? file->GetSize() : 0)
+    {
+    }
+
+    MappedInputStream::MappedInputStream(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t size) :
+        m_file(std::move(file)),
+        m_data(nullptr),
+        m_size(0),
+        m_position(0)
+    {
+        if (m_file && m_file->GetData() && offset < m_file->GetSize())
+        {
+            m_data = m_file->GetData() + offset;
+            m_size = std::min(size, m_file->GetSize() - offset);
+        }
+    }
+
+    sf::Int64 MappedInputStream::read(void *data, sf::Int64 size)
+    {
+        if (size <= 0)
+            return 0;
+
+        auto count = std::min(static_cast<std::size_t>(size), m_size - m_position);
+        if (count > 0)
+            std::memcpy(data, m_data + m_position, count);
+
+        m_position += count;
+        return static_cast<sf::Int64>(count);
+    }
+
+    sf::Int64 MappedInputStream::seek(sf::Int64 position)
+    {
+        if (position < 0)
+            return -1;
+
+        m_position = std::min(static_cast<std::size_t>(position), m_size);
+        return static_cast<sf::Int64>(m_position);
+    }
+
+    sf::Int64 MappedInputStream::tell()
+    {
+        return static_cast<sf::Int64>(m_position);
+    }
+
+    sf::Int64 MappedInputStream::getSize()
+    {
+        return static_cast<sf::Int64>(m_size);
+    }
+
+    const unsigned char *MappedInputStream::GetData() const
+    {
+        return m_data;
+    }
+}
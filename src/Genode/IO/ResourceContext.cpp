@@ -1,4 +1,5 @@
 #include <Genode/IO/ResourceContext.hpp>
+#include <Genode/IO/ResourceManager.hpp>
 #include <utility>
 
 namespace Gx
@@ -7,19 +8,22 @@ namespace Gx
 
     ResourceContext::ResourceContext() noexcept :
         m_id(),
-        m_resources()
+        m_resources(),
+        m_scheduler()
     {
     }
 
     ResourceContext::ResourceContext(std::string id) :
         m_id(std::move(id)),
-        m_resources(nullptr)
+        m_resources(nullptr),
+        m_scheduler(nullptr)
     {
     }
 
     ResourceContext::ResourceContext(std::string id, ResourceManager &resources) :
         m_id(std::move(id)),
-        m_resources(&resources)
+        m_resources(&resources),
+        m_scheduler(nullptr)
     {
     }
 
@@ -27,4 +31,9 @@ namespace Gx
     {
         return m_id;
     }
+
+    bool ResourceContext::IsUploadDeferred() const
+    {
+        return m_resources && m_resources->IsUploadDeferred();
+    }
 }
@@ -0,0 +1,10 @@
+#include <Genode/IO/ResourceLoaderFactory.hpp>
+
+namespace Gx
+{
+    void ResourceLoaderFactory::UseCachedLoaders(bool cache)
+    {
+        m_cached = cache;
+        m_version++;
+    }
+}
@@ -1,10 +1,34 @@
 #include <Genode/IO/ResourceManager.hpp>
 #include <Genode/IO/ResourceContext.hpp>
+#include <Genode/IO/IOException.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
 
 namespace Gx
 {
     ResourceManager::ResourceManager() :
-        m_containers()
+        m_containers(),
+        m_mutex(),
+        m_workers(),
+        m_workerCount(0),
+        m_workersMutex(),
+        m_peakBytes(0),
+        m_inFlight(),
+        m_waits(),
+        m_inFlightMutex(),
+        m_uploads(),
+        m_uploadSink(std::make_shared<TextureUploadSink>()),
+        m_uploadsMutex(),
+        m_deferUploads(false),
+        m_failedUploads(0),
+        m_graph(),
+        m_graphTypes(),
+        m_graphMutex(),
+        m_trackDependencies(false)
     {
         m_contextFactory = [] (const std::string &id, ResourceManager &manager) {
             return std::make_unique<ResourceContext>(id, manager);
@@ -13,11 +37,554 @@ namespace Gx
 
     ResourceManager::~ResourceManager()
     {
-       Clear();
+        // Pending loads must be committed before the containers are gone
+        m_workers = nullptr;
+        Clear();
+    }
+
+    void ResourceManager::SetWorkerCount(std::size_t count)
+    {
+        std::shared_ptr<ThreadPool> workers;
+        {
+            std::lock_guard<std::mutex> lock(m_workersMutex);
+            m_workerCount = count;
+            workers       = std::move(m_workers);
+        }
+
+        // Finishing the pending loads may queue nested loads, which will be run by the new worker threads
+        // Wait may still hold the previous pool, in which case it is destroyed once Wait returns
+        if (workers)
+            workers->Wait();
+    }
+
+    void ResourceManager::Wait()
+    {
+        // The pool is shared so SetWorkerCount can't destroy it while waiting
+        std::shared_ptr<ThreadPool> workers;
+        {
+            std::lock_guard<std::mutex> lock(m_workersMutex);
+            workers = m_workers;
+        }
+
+        if (workers)
+            workers->Wait();
+    }
+
+    void ResourceManager::UseDeferredUploads(bool defer)
+    {
+        m_deferUploads = defer;
+    }
+
+    bool ResourceManager::IsUploadDeferred() const
+    {
+        return m_deferUploads;
+    }
+
+    void ResourceManager::SetUploadSink(std::shared_ptr<IUploadSink> sink)
+    {
+        std::lock_guard<std::mutex> lock(m_uploadsMutex);
+        m_uploadSink = sink ? std::move(sink) : std::make_shared<TextureUploadSink>();
+    }
+
+    std::size_t ResourceManager::PumpUploads(sf::Time budget, std::size_t byteBudget)
+    {
+        auto start    = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::microseconds(budget.asMicroseconds());
+
+        std::size_t count = 0, bytes = 0;
+        while (true)
+        {
+            PendingUpload upload;
+            std::shared_ptr<IUploadSink> sink;
+            {
+                std::lock_guard<std::mutex> lock(m_uploadsMutex);
+                if (m_uploads.empty() || (count > 0 && bytes + m_uploads.front().Bytes > byteBudget))
+                    break;
+
+                upload = std::move(m_uploads.front());
+                sink   = m_uploadSink;
+                m_uploads.pop_front();
+            }
+
+            upload.Upload(*sink);
+            bytes += upload.Bytes;
+            count++;
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+        }
+
+        return count;
+    }
+
+    std::size_t ResourceManager::GetPendingUploadCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_uploadsMutex);
+        return m_uploads.size();
+    }
+
+    std::size_t ResourceManager::GetFailedUploadCount() const
+    {
+        return m_failedUploads;
     }
 
     void ResourceManager::Clear()
     {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
         m_containers.clear();
+
+        std::lock_guard<std::mutex> graphLock(m_graphMutex);
+        for (std::size_t i = 0; i < m_graph.GetNodeCount(); i++)
+            m_graph.GetNode(i).Explicit = false;
+    }
+
+    void ResourceManager::UseDependencyTracking(bool track)
+    {
+        m_trackDependencies = track;
+    }
+
+    DependencyGraph ResourceManager::GetDependencyGraph() const
+    {
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        return m_graph;
+    }
+
+    bool ResourceManager::SaveManifest(const std::string &fileName) const
+    {
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        return m_graph.Save(fileName);
+    }
+
+    bool ResourceManager::LoadManifest(const std::string &fileName)
+    {
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+        return m_graph.Load(fileName);
+    }
+
+    std::size_t ResourceManager::Preload()
+    {
+        struct Task
+        {
+            void                   (*Load)(ResourceManager&, const std::string&, const std::string&);
+            std::string              ID;
+            std::string              FileName;
+            std::atomic<std::size_t> Pending;
+            std::vector<std::size_t> Dependents;
+        };
+
+        struct Batch
+        {
+            std::deque<Task>        Tasks;
+            std::mutex              Mutex;
+            std::condition_variable Completed;
+            std::size_t             Remaining = 0;
+            std::size_t             Loaded    = 0;
+            std::exception_ptr      Error;
+        };
+
+        // Tasks are ordered so every task comes after the tasks of its dependencies
+        auto batch = std::make_shared<Batch>();
+        {
+            std::lock_guard<std::mutex> lock(m_graphMutex);
+
+            auto order = m_graph.Sort();
+            auto tasks = std::vector<std::size_t>(m_graph.GetNodeCount(), DependencyGraph::NoNode);
+            for (auto index : order)
+            {
+                auto &node = m_graph.GetNode(index);
+                auto type  = m_graphTypes.find(node.Type);
+                if (node.FileName.empty() || type == m_graphTypes.end())
+                    continue;
+
+                tasks[index] = batch->Tasks.size();
+                auto &task   = batch->Tasks.emplace_back();
+                task.Load     = type->second.Load;
+                task.ID       = node.ID;
+                task.FileName = node.FileName;
+                task.Pending  = 0;
+                for (auto dependency : node.Dependencies)
+                {
+                    if (tasks[dependency] != DependencyGraph::NoNode)
+                    {
+                        task.Pending++;
+                        batch->Tasks[tasks[dependency]].Dependents.push_back(tasks[index]);
+                    }
+                }
+            }
+
+            batch->Remaining = batch->Tasks.size();
+        }
+
+        struct Scheduler
+        {
+            static void Run(ResourceManager &manager, const std::shared_ptr<Batch> &batch, std::size_t index)
+            {
+                auto &task = batch->Tasks[index];
+                try
+                {
+                    // Resources loaded by Preload are not added directly
+                    LoadScope scope({ &manager, nullptr, {} });
+                    task.Load(manager, task.ID, task.FileName);
+
+                    std::lock_guard<std::mutex> lock(batch->Mutex);
+                    batch->Loaded++;
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(batch->Mutex);
+                    if (!batch->Error)
+                        batch->Error = std::current_exception();
+                }
+
+                // Dependents are scheduled even when the load failed, their loaders will report the missing dependency
+                for (auto dependent : task.Dependents)
+                {
+                    if (--batch->Tasks[dependent].Pending == 0)
+                        manager.GetWorkers().Enqueue([&manager, batch, dependent] () { Run(manager, batch, dependent); });
+                }
+
+                std::lock_guard<std::mutex> lock(batch->Mutex);
+                if (--batch->Remaining == 0)
+                    batch->Completed.notify_all();
+            }
+        };
+
+        // Waiting for the worker threads from one of them may never finish, the tasks are run in order instead
+        if (GetWorkers().IsWorkerThread())
+        {
+            for (std::size_t i = 0; i < batch->Tasks.size(); i++)
+                Scheduler::Run(*this, batch, i);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < batch->Tasks.size(); i++)
+            {
+                if (batch->Tasks[i].Pending == 0)
+                    GetWorkers().Enqueue([this, batch, i] () { Scheduler::Run(*this, batch, i); });
+            }
+
+            std::unique_lock<std::mutex> lock(batch->Mutex);
+            batch->Completed.wait(lock, [&batch] { return batch->Remaining == 0; });
+        }
+
+        if (batch->Error)
+            std::rethrow_exception(batch->Error);
+
+        return batch->Loaded;
+    }
+
+    ResourceStats ResourceManager::GetStats(std::size_t largestCount) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        ResourceStats stats;
+        for (auto &managed : m_containers)
+        {
+            if (!managed)
+                continue;
+
+            auto typeStats = managed->GetStats(largestCount);
+            stats.Bytes += typeStats.Bytes;
+            stats.Types.push_back(std::move(typeStats));
+        }
+
+        stats.PeakBytes = std::max(m_peakBytes, stats.Bytes);
+        return stats;
+    }
+
+    void ResourceManager::UpdatePeak() const
+    {
+        // The caller must hold m_mutex exclusively
+        std::size_t bytes = 0;
+        for (auto &managed : m_containers)
+        {
+            if (managed)
+                bytes += managed->GetResidentBytes();
+        }
+
+        m_peakBytes = std::max(m_peakBytes, bytes);
+    }
+
+    std::size_t ResourceManager::InFlightKeyHash::operator()(const InFlightKey &key) const
+    {
+        return std::hash<std::string>()(key.second) ^ (key.first * 0x9E3779B97F4A7C15ull);
+    }
+
+    std::shared_ptr<ResourceManager::InFlightLoad> ResourceManager::JoinLoad(std::size_t type, const std::string &id, bool &owner)
+    {
+        std::lock_guard<std::mutex> lock(m_inFlightMutex);
+
+        auto &load = m_inFlight[{ type, id }];
+        if (load)
+        {
+            // Waiting for a load that owned by the calling thread would never finish
+            if (load->Owner == std::this_thread::get_id())
+                throw ResourceLoadException("[" + id + "] Resource depends on itself.");
+
+            owner = false;
+            return load;
+        }
+
+        load        = std::make_shared<InFlightLoad>();
+        load->Owner = std::this_thread::get_id();
+        owner       = true;
+
+        return load;
+    }
+
+    std::shared_ptr<ResourceManager::InFlightLoad> ResourceManager::FindLoad(std::size_t type, const std::string &id) const
+    {
+        std::lock_guard<std::mutex> lock(m_inFlightMutex);
+
+        auto it = m_inFlight.find({ type, id });
+        if (it == m_inFlight.end() || it->second->Owner == std::this_thread::get_id())
+            return nullptr;
+
+        return it->second;
+    }
+
+    void ResourceManager::CompleteLoad(std::size_t type, const std::string &id, InFlightLoad &load, void *resource, std::exception_ptr error)
+    {
+        {
+            // Completed load has no owner, so it no longer takes part in the cycles of WaitLoad
+            std::lock_guard<std::mutex> lock(m_inFlightMutex);
+            m_inFlight.erase({ type, id });
+            load.Owner = std::thread::id();
+        }
+
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(load.Mutex);
+            load.Resource = resource;
+            load.Error    = std::move(error);
+            load.Done     = true;
+
+            continuations = std::move(load.Continuations);
+        }
+
+        load.Completed.notify_all();
+        for (auto &continuation : continuations)
+            continuation();
+    }
+
+    void ResourceManager::DetachLoad(InFlightLoad &load)
+    {
+        // Coroutine loads are resumed on any worker thread, their owner is not blocked by waiting for the load
+        std::lock_guard<std::mutex> lock(m_inFlightMutex);
+        load.Owner = std::thread::id();
+    }
+
+    void ResourceManager::ContinueLoad(InFlightLoad &load, std::function<void()> continuation)
+    {
+        {
+            std::lock_guard<std::mutex> lock(load.Mutex);
+            if (!load.Done)
+            {
+                load.Continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+
+        continuation();
+    }
+
+    void *ResourceManager::WaitLoad(InFlightLoad &load, const std::string &id) const
+    {
+        auto self = std::this_thread::get_id();
+        {
+            // Follow the owners that are waiting for another load, waiting would never finish if the chain leads back to this thread
+            std::lock_guard<std::mutex> lock(m_inFlightMutex);
+            for (auto owner = load.Owner; owner != std::thread::id();)
+            {
+                if (owner == self)
+                    throw ResourceLoadException("[" + id + "] Resource depends on itself through the load of another thread.");
+
+                auto wait = m_waits.find(owner);
+                if (wait == m_waits.end())
+                    break;
+
+                owner = wait->second->Owner;
+            }
+
+            m_waits[self] = &load;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(load.Mutex);
+            load.Completed.wait(lock, [&load] { return load.Done; });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_inFlightMutex);
+            m_waits.erase(self);
+        }
+
+        if (load.Error)
+            std::rethrow_exception(load.Error);
+
+        return load.Resource;
+    }
+
+    std::vector<ResourceManager::LoadFrame> &ResourceManager::GetLoadFrames()
+    {
+        thread_local std::vector<LoadFrame> frames;
+        return frames;
+    }
+
+    const ResourceManager::LoadFrame *ResourceManager::GetCurrentLoad() const
+    {
+        auto &frames = GetLoadFrames();
+        if (frames.empty() || frames.back().Manager != this)
+            return nullptr;
+
+        return &frames.back();
+    }
+
+    std::shared_ptr<const ResourceManager::LoadChain> ResourceManager::CaptureChain() const
+    {
+        // Loads of the calling thread along with the loads that wait for them
+        auto chain = std::make_shared<LoadChain>();
+        for (auto &frame : GetLoadFrames())
+        {
+            if (frame.Manager != this)
+                continue;
+
+            if (frame.Chain)
+                chain->insert(chain->end(), frame.Chain->begin(), frame.Chain->end());
+
+            if (frame.Type)
+                chain->emplace_back(frame.Type, std::string(frame.ID));
+        }
+
+        return chain->empty() ? nullptr : std::move(chain);
+    }
+
+    bool ResourceManager::IsAwaitedBy(const char *type, const std::string &id) const
+    {
+        // Detached loads have no owner, so waiting for one of the loads that wait for the calling thread can only be detected by the chain
+        for (auto &frame : GetLoadFrames())
+        {
+            if (frame.Manager != this)
+                continue;
+
+            if (frame.Type && frame.ID == id && std::strcmp(frame.Type, type) == 0)
+                return true;
+
+            if (frame.Chain)
+            {
+                for (auto &link : *frame.Chain)
+                {
+                    if (link.second == id && link.first == type)
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void ResourceManager::ReleaseDependencies(const std::string &type, const std::string &id)
+    {
+        // The caller must hold m_mutex exclusively
+        std::lock_guard<std::mutex> lock(m_graphMutex);
+
+        auto root = m_graph.Find(type, id);
+        if (root == DependencyGraph::NoNode)
+            return;
+
+        auto findContainer = [this] (const DependencyGraph::Node &node) -> IManagedContainer* {
+            auto it = m_graphTypes.find(node.Type);
+            if (it == m_graphTypes.end() || it->second.Index >= m_containers.size())
+                return nullptr;
+
+            return m_containers[it->second.Index].get();
+        };
+        auto isStored = [&] (std::size_t index) {
+            auto &node     = m_graph.GetNode(index);
+            auto container = findContainer(node);
+            return container && container->Contains(node.ID);
+        };
+
+        m_graph.GetNode(root).Explicit = false;
+        std::vector<std::size_t> released = { root };
+        while (!released.empty())
+        {
+            auto index = released.back();
+            released.pop_back();
+
+            for (auto dependency : m_graph.GetNode(index).Dependencies)
+            {
+                auto &node     = m_graph.GetNode(dependency);
+                auto container = findContainer(node);
+                if (node.Explicit || !container || !container->Contains(node.ID))
+                    continue;
+
+                // Keep the dependency while another stored resource depends on it
+                if (std::any_of(node.Dependents.begin(), node.Dependents.end(), isStored))
+                    continue;
+
+                if (container->Destroy(node.ID))
+                    released.push_back(dependency);
+            }
+        }
+    }
+
+    std::vector<ResourceManager::PendingUpload> &ResourceManager::GetStagedUploads()
+    {
+        // Nested loads on the same thread stage their uploads on top of the outer load and publish them first
+        thread_local std::vector<PendingUpload> staged;
+        return staged;
+    }
+
+    void ResourceManager::PublishUploads(std::size_t mark) const
+    {
+        auto &staged = GetStagedUploads();
+        if (staged.size() <= mark)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_uploadsMutex);
+            for (auto it = staged.begin() + static_cast<std::ptrdiff_t>(mark); it != staged.end(); ++it)
+                m_uploads.push_back(std::move(*it));
+        }
+
+        staged.resize(mark);
+    }
+
+    void ResourceManager::DiscardUploads(std::size_t mark)
+    {
+        auto &staged = GetStagedUploads();
+        if (staged.size() > mark)
+            staged.resize(mark);
+    }
+
+    void ResourceManager::EnqueueUploads(std::vector<PendingUpload> &uploads) const
+    {
+        if (uploads.empty())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_uploadsMutex);
+            for (auto &upload : uploads)
+                m_uploads.push_back(std::move(upload));
+        }
+
+        uploads.clear();
+    }
+
+    std::size_t ResourceManager::AllocateTypeIndex()
+    {
+        // Defined out of line so every module shares the same sequence of type indices
+        static std::atomic<std::size_t> next = 0;
+        return next++;
+    }
+
+    ThreadPool &ResourceManager::GetWorkers()
+    {
+        std::lock_guard<std::mutex> lock(m_workersMutex);
+        if (!m_workers)
+            m_workers = std::make_shared<ThreadPool>(m_workerCount);
+
+        return *m_workers;
     }
-}
\ No newline at end of file
+}
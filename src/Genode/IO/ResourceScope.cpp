@@ -0,0 +1,108 @@
+#include <Genode/IO/ResourceScope.hpp>
+
+#include <exception>
+
+namespace Gx
+{
+    ResourceScope::ResourceScope(ResourceManager &manager) :
+        m_manager(manager),
+        m_blocks(),
+        m_count(0),
+        m_mutex()
+    {
+    }
+
+    ResourceScope::~ResourceScope()
+    {
+        Release();
+    }
+
+    ResourceManager &ResourceScope::GetManager() const
+    {
+        return m_manager;
+    }
+
+    void ResourceScope::Preload(const std::vector<Entry> &entries)
+    {
+        std::vector<std::string> fileNames;
+        fileNames.reserve(entries.size());
+        for (auto &entry : entries)
+            fileNames.push_back(entry.FileName);
+
+        // Warm the page cache while the loads are queued
+        FileSystem::Prefetch(fileNames);
+
+        std::vector<std::function<void()>> loads;
+        loads.reserve(entries.size());
+        for (auto &entry : entries)
+            loads.push_back(entry.Load(*this, entry));
+
+        // Every load must be completed before returning, even when some of them failed
+        std::exception_ptr error;
+        for (auto &load : loads)
+        {
+            try
+            {
+                load();
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    std::size_t ResourceScope::Count() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_count;
+    }
+
+    std::size_t ResourceScope::Release()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count == 0)
+            return 0;
+
+        std::size_t count = 0;
+        {
+            std::unique_lock<std::shared_mutex> managerLock(m_manager.m_mutex);
+
+            auto &containers = m_manager.m_containers;
+            for (std::size_t i = 0; i < m_count; i++)
+            {
+                auto &record = m_blocks[i / BlockSize][i % BlockSize];
+                if (record.Type >= containers.size() || !containers[record.Type])
+                    continue;
+
+                auto &container = containers[record.Type];
+                auto id = m_manager.m_trackDependencies ? container->GetID(record.Index, record.Generation) : std::string();
+                if (!container->Untag(record.Index, record.Generation))
+                    continue;
+
+                if (!id.empty())
+                    m_manager.ReleaseDependencies(container->GetTypeName(), id);
+
+                count++;
+            }
+        }
+
+        // Blocks are kept for the next group of resources
+        m_count = 0;
+        return count;
+    }
+
+    void ResourceScope::Track(std::size_t type, std::uint32_t index, std::uint32_t generation)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count / BlockSize == m_blocks.size())
+            m_blocks.push_back(std::make_unique<Record[]>(BlockSize));
+
+        m_blocks[m_count / BlockSize][m_count % BlockSize] = { static_cast<std::uint32_t>(type), index, generation };
+        m_count++;
+    }
+}
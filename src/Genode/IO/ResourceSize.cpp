@@ -0,0 +1,48 @@
+#include <Genode/IO/ResourceSize.hpp>
+
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Font.hpp>
+
+#include <Genode/IO/AudioStream.hpp>
+#include <Genode/IO/TextureAtlas.hpp>
+
+namespace Gx
+{
+    std::size_t ResourceSize<sf::Texture>::Get(const sf::Texture &resource, std::size_t)
+    {
+        // Texture doesn't expose whether it has mipmap, assume it has to stay on the safe side of the budget
+        auto size  = resource.getSize();
+        auto bytes = static_cast<std::size_t>(size.x) * size.y * 4;
+
+        return bytes + bytes / 3;
+    }
+
+    std::size_t ResourceSize<TextureAtlas>::Get(const TextureAtlas &resource, std::size_t)
+    {
+        // Atlas pages are not mipmapped, mipmaps would bleed the neighbouring regions
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < resource.GetPageCount(); i++)
+        {
+            auto size = resource.GetTexture(i).getSize();
+            bytes += static_cast<std::size_t>(size.x) * size.y * 4;
+        }
+
+        return bytes;
+    }
+
+    std::size_t ResourceSize<sf::SoundBuffer>::Get(const sf::SoundBuffer &resource, std::size_t)
+    {
+        return static_cast<std::size_t>(resource.getSampleCount()) * sizeof(sf::Int16);
+    }
+
+    std::size_t ResourceSize<AudioStream>::Get(const AudioStream &resource, std::size_t)
+    {
+        return resource.GetSourceSize() + resource.GetBufferSize();
+    }
+
+    std::size_t ResourceSize<sf::Font>::Get(const sf::Font &, std::size_t sourceSize)
+    {
+        return sourceSize > 0 ? sourceSize : sizeof(sf::Font);
+    }
+}
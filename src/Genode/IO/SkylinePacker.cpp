@@ -0,0 +1,118 @@
+#include <Genode/IO/SkylinePacker.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace Gx
+{
+    SkylinePacker::SkylinePacker(unsigned width, unsigned height) :
+        m_skyline({ { 0, 0, width } }),
+        m_width(width),
+        m_height(height),
+        m_usedHeight(0)
+    {
+    }
+
+    bool SkylinePacker::Insert(unsigned width, unsigned height, sf::Vector2u &position)
+    {
+        if (width == 0 || height == 0)
+        {
+            position = { 0, 0 };
+            return true;
+        }
+
+        auto bestIndex  = m_skyline.size();
+        auto bestBottom = std::numeric_limits<unsigned>::max();
+        auto bestWidth  = std::numeric_limits<unsigned>::max();
+        for (std::size_t i = 0; i < m_skyline.size(); i++)
+        {
+            unsigned y;
+            if (!Fit(i, width, height, y))
+                continue;
+
+            // Prefer the lowest position, then the narrowest segment to keep the wide ones for wide rectangles
+            auto bottom = y + height;
+            if (bottom < bestBottom || (bottom == bestBottom && m_skyline[i].Width < bestWidth))
+            {
+                bestIndex  = i;
+                bestBottom = bottom;
+                bestWidth  = m_skyline[i].Width;
+                position   = { m_skyline[i].X, y };
+            }
+        }
+
+        if (bestIndex == m_skyline.size())
+            return false;
+
+        // Raise the skyline under the rectangle, then cut the segments that it covers
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), { position.x, bestBottom, width });
+        for (auto i = bestIndex + 1; i < m_skyline.size();)
+        {
+            auto &previous = m_skyline[i - 1];
+            auto &segment  = m_skyline[i];
+            auto right     = previous.X + previous.Width;
+            if (segment.X >= right)
+                break;
+
+            auto shrink = right - segment.X;
+            if (segment.Width <= shrink)
+            {
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+
+            segment.X     += shrink;
+            segment.Width -= shrink;
+            break;
+        }
+
+        // Merge the neighbouring segments of the same height
+        for (std::size_t i = 0; i + 1 < m_skyline.size();)
+        {
+            if (m_skyline[i].Y == m_skyline[i + 1].Y)
+            {
+                m_skyline[i].Width += m_skyline[i + 1].Width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+                i++;
+        }
+
+        m_usedHeight = std::max(m_usedHeight, bestBottom);
+        return true;
+    }
+
+    sf::Vector2u SkylinePacker::GetSize() const
+    {
+        return { m_width, m_height };
+    }
+
+    unsigned SkylinePacker::GetUsedHeight() const
+    {
+        return m_usedHeight;
+    }
+
+    bool SkylinePacker::Fit(std::size_t index, unsigned width, unsigned height, unsigned &y) const
+    {
+        auto x = m_skyline[index].X;
+        if (x + width > m_width)
+            return false;
+
+        // The rectangle rests on the highest segment it spans
+        y = 0;
+        auto remaining = width;
+        for (auto i = index; remaining > 0; i++)
+        {
+            if (i == m_skyline.size())
+                return false;
+
+            y = std::max(y, m_skyline[i].Y);
+            if (y + height > m_height)
+                return false;
+
+            remaining -= std::min(remaining, m_skyline[i].Width);
+        }
+
+        return true;
+    }
+}
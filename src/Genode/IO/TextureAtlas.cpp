@@ -0,0 +1,50 @@
+#include <Genode/IO/TextureAtlas.hpp>
+
+#include <SFML/Graphics/Texture.hpp>
+
+namespace Gx
+{
+    TextureAtlas::TextureAtlas() = default;
+
+    TextureAtlas::~TextureAtlas() = default;
+
+    std::size_t TextureAtlas::AddTexture(std::unique_ptr<sf::Texture> texture)
+    {
+        m_pages.push_back(std::move(texture));
+        return m_pages.size() - 1;
+    }
+
+    void TextureAtlas::AddRegion(const std::string &name, const Region &region)
+    {
+        m_regions[name] = region;
+    }
+
+    const TextureAtlas::Region *TextureAtlas::FindRegion(const std::string &name) const
+    {
+        auto it = m_regions.find(name);
+        if (it == m_regions.end())
+            return nullptr;
+
+        return &it->second;
+    }
+
+    sf::Texture &TextureAtlas::GetTexture(std::size_t page)
+    {
+        return *m_pages.at(page);
+    }
+
+    const sf::Texture &TextureAtlas::GetTexture(std::size_t page) const
+    {
+        return *m_pages.at(page);
+    }
+
+    std::size_t TextureAtlas::GetPageCount() const
+    {
+        return m_pages.size();
+    }
+
+    std::size_t TextureAtlas::GetRegionCount() const
+    {
+        return m_regions.size();
+    }
+}
@@ -0,0 +1,16 @@
+#include <Genode/IO/UploadSink.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace Gx
+{
+    bool TextureUploadSink::Upload(sf::Texture &texture, const sf::Image &image, bool smooth)
+    {
+        if (!texture.loadFromImage(image))
+            return false;
+
+        texture.setSmooth(smooth);
+        return true;
+    }
+}
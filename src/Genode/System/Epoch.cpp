@@ -0,0 +1,175 @@
+#include <Genode/System/Epoch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Gx
+{
+    namespace
+    {
+        constexpr std::size_t CollectThreshold = 64;
+
+        // Records are never freed, they are recycled by new threads once their owner thread exit
+        struct alignas(64) Record
+        {
+            std::atomic<std::uint64_t> Active = 0;
+            std::atomic<bool>          InUse  = true;
+            Record                    *Next   = nullptr;
+        };
+
+        struct Retired
+        {
+            void           *Object;
+            Epoch::Deleter  Deleter;
+            std::uint64_t   Stamp;
+        };
+
+        struct RetireList
+        {
+            ~RetireList()
+            {
+                for (auto &retired : Objects)
+                    retired.Deleter(retired.Object);
+            }
+
+            std::mutex           Mutex;
+            std::vector<Retired> Objects;
+            std::size_t          Retirements = 0;
+        };
+
+        std::atomic<std::uint64_t> GlobalEpoch = 1;
+        std::atomic<Record*>       Records     = nullptr;
+        RetireList                 RetiredObjects;
+
+        Record *AcquireRecord()
+        {
+            for (auto record = Records.load(std::memory_order_acquire); record; record = record->Next)
+            {
+                bool expected = false;
+                if (!record->InUse.load(std::memory_order_relaxed) && record->InUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return record;
+            }
+
+            auto record = new Record();
+            record->Next = Records.load(std::memory_order_relaxed);
+            while (!Records.compare_exchange_weak(record->Next, record, std::memory_order_release, std::memory_order_relaxed))
+                continue;
+
+            return record;
+        }
+
+        struct ThreadState
+        {
+            ~ThreadState()
+            {
+                if (!Slot)
+                    return;
+
+                Slot->Active.store(0, std::memory_order_release);
+                Slot->InUse.store(false, std::memory_order_release);
+            }
+
+            Record      *Slot  = nullptr;
+            std::size_t  Depth = 0;
+        };
+
+        thread_local ThreadState CurrentThread;
+
+        // The caller must hold the retire list mutex
+        bool TryAdvance()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto epoch = GlobalEpoch.load(std::memory_order_relaxed);
+            for (auto record = Records.load(std::memory_order_acquire); record; record = record->Next)
+            {
+                auto active = record->Active.load(std::memory_order_seq_cst);
+                if (active != 0 && active != epoch)
+                    return false;
+            }
+
+            GlobalEpoch.store(epoch + 1, std::memory_order_seq_cst);
+            return true;
+        }
+    }
+
+    void Epoch::Enter()
+    {
+        auto &thread = CurrentThread;
+        if (thread.Depth++ > 0)
+            return;
+
+        if (!thread.Slot)
+            thread.Slot = AcquireRecord();
+
+        // Publish the observed epoch and validate it did not move in between,
+        // otherwise the collector could have skipped this reader while advancing twice
+        auto epoch = GlobalEpoch.load(std::memory_order_seq_cst);
+        while (true)
+        {
+            thread.Slot->Active.store(epoch, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto current = GlobalEpoch.load(std::memory_order_seq_cst);
+            if (current == epoch)
+                break;
+
+            epoch = current;
+        }
+    }
+
+    void Epoch::Leave()
+    {
+        auto &thread = CurrentThread;
+        if (--thread.Depth == 0)
+            thread.Slot->Active.store(0, std::memory_order_release);
+    }
+
+    void Epoch::Retire(void *object, Deleter deleter)
+    {
+        bool collect;
+        {
+            std::lock_guard<std::mutex> lock(RetiredObjects.Mutex);
+            RetiredObjects.Objects.push_back({ object, deleter, GlobalEpoch.load(std::memory_order_seq_cst) });
+            collect = ++RetiredObjects.Retirements % CollectThreshold == 0;
+        }
+
+        if (collect)
+            Collect();
+    }
+
+    void Epoch::Collect()
+    {
+        std::vector<Retired> expired;
+        {
+            std::lock_guard<std::mutex> lock(RetiredObjects.Mutex);
+            TryAdvance();
+
+            // Readers may still observe objects retired within the previous epoch
+            auto epoch    = GlobalEpoch.load(std::memory_order_relaxed);
+            auto &objects = RetiredObjects.Objects;
+            auto pending  = std::vector<Retired>();
+            for (auto &retired : objects)
+            {
+                if (retired.Stamp + 2 <= epoch)
+                    expired.push_back(retired);
+                else
+                    pending.push_back(retired);
+            }
+
+            objects = std::move(pending);
+        }
+
+        // Deleters may retire other objects, so they are invoked outside of the lock
+        for (auto &retired : expired)
+            retired.Deleter(retired.Object);
+    }
+
+    std::size_t Epoch::GetPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(RetiredObjects.Mutex);
+        return RetiredObjects.Objects.size();
+    }
+}
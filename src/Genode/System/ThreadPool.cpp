@@ -0,0 +1,91 @@
+#include <Genode/System/ThreadPool.hpp>
+
+#include <algorithm>
+
+namespace Gx
+{
+    ThreadPool::ThreadPool(std::size_t workerCount) :
+        m_workers(),
+        m_tasks(),
+        m_mutex(),
+        m_available(),
+        m_idle(),
+        m_running(0),
+        m_stopping(false)
+    {
+        if (workerCount == 0)
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+        m_workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; i++)
+            m_workers.emplace_back([this] { Run(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_available.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push(std::move(task));
+        }
+
+        m_available.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_tasks.empty() && m_running == 0; });
+    }
+
+    std::size_t ThreadPool::GetWorkerCount() const
+    {
+        return m_workers.size();
+    }
+
+    bool ThreadPool::IsWorkerThread() const
+    {
+        auto id = std::this_thread::get_id();
+        return std::any_of(m_workers.begin(), m_workers.end(), [&] (auto &worker) { return worker.get_id() == id; });
+    }
+
+    void ThreadPool::Run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_available.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+
+                // Queued tasks are always drained before the pool stops
+                if (m_tasks.empty())
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+                m_running++;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_running--;
+                if (m_tasks.empty() && m_running == 0)
+                    m_idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#include <iostream>
+
+#include <Genode/IO/FileSystems/PackFileSystem.hpp>
+#include <Genode/IO/IOException.hpp>
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: genode-pack <directory> <archive>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        auto writer = Gx::PackWriter();
+        writer.AddDirectory(argv[1]);
+        writer.Save(argv[2]);
+
+        std::cout << "Packed " << writer.GetEntryCount() << " files into " << argv[2] << std::endl;
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}